@@ -131,6 +131,35 @@ static void hitaki_alsa_firewire_default_init(HitakiAlsaFirewireInterface *iface
                              "Whether the sound card is unavailable",
                              FALSE,
                              G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY));
+
+    /**
+     * HitakiAlsaFirewire:dispatch-budget:
+     *
+     * The maximum number of events handled in one dispatch of [struct@GLib.Source] retrieved by
+     * [method@AlsaFirewire.create_source] or [method@AlsaFirewireMux.create_source]. When the
+     * value is larger than 1, the source drains queued events up to the value in one dispatch,
+     * thus burst of events is handled without iteration of main loop per event. The bound
+     * prevents the source from starving the other sources in the same main context.
+     */
+    g_object_interface_install_property(iface,
+        g_param_spec_uint(DISPATCH_BUDGET_PROP_NAME, DISPATCH_BUDGET_PROP_NAME,
+                          "The maximum number of events handled in one dispatch",
+                          1, G_MAXUINT,
+                          DEFAULT_DISPATCH_BUDGET,
+                          G_PARAM_READWRITE));
+
+    /**
+     * HitakiAlsaFirewire:event-ring:
+     *
+     * The [class@EventRing] to which the decoded events are pushed in addition to signals, so that
+     * the thread for real time processing can consume them without GObject. It should be assigned
+     * before the source is attached to main context.
+     */
+    g_object_interface_install_property(iface,
+        g_param_spec_object(EVENT_RING_PROP_NAME, EVENT_RING_PROP_NAME,
+                            "The queue to which the decoded events are pushed",
+                            HITAKI_TYPE_EVENT_RING,
+                            G_PARAM_READWRITE));
 }
 
 /**
@@ -140,7 +169,9 @@ static void hitaki_alsa_firewire_default_init(HitakiAlsaFirewireInterface *iface
  * @open_flag: The flag of `open(2)` system call.
  * @error: A [struct@GLib.Error].
  *
- * Open the special file for ALSA HwDep character device.
+ * Open the special file for ALSA HwDep character device. The path with `loopback:` prefix followed
+ * by the name of type, e.g. `loopback:tascam`, selects the in-process device which emulates the
+ * character device without any FireWire bus.
  *
  * Returns: TRUE if the overall operation finished successfully, else FALSE.
  */
@@ -209,3 +240,42 @@ gboolean hitaki_alsa_firewire_create_source(HitakiAlsaFirewire *self, GSource **
 
     return HITAKI_ALSA_FIREWIRE_GET_IFACE(self)->create_source(self, source, error);
 }
+
+/**
+ * hitaki_alsa_firewire_get_stats:
+ * @self: A [iface@AlsaFirewire].
+ * @stats: (out)(transfer full): A [struct@AlsaFirewireStats] for the snapshot of statistics.
+ *
+ * Take the snapshot of runtime statistics about events from ALSA HwDep character device. The
+ * counters are zero for the implementation which does not maintain them.
+ */
+void hitaki_alsa_firewire_get_stats(HitakiAlsaFirewire *self, HitakiAlsaFirewireStats **stats)
+{
+    struct alsa_firewire_state *state;
+
+    g_return_if_fail(HITAKI_IS_ALSA_FIREWIRE(self));
+    g_return_if_fail(stats != NULL);
+
+    *stats = hitaki_alsa_firewire_stats_new();
+
+    state = alsa_firewire_state_from_unit(self);
+    if (state != NULL)
+        alsa_firewire_state_snapshot_stats(state, (struct alsa_firewire_stats *)*stats);
+}
+
+/**
+ * hitaki_alsa_firewire_reset_stats:
+ * @self: A [iface@AlsaFirewire].
+ *
+ * Reset the counters of runtime statistics to zero.
+ */
+void hitaki_alsa_firewire_reset_stats(HitakiAlsaFirewire *self)
+{
+    struct alsa_firewire_state *state;
+
+    g_return_if_fail(HITAKI_IS_ALSA_FIREWIRE(self));
+
+    state = alsa_firewire_state_from_unit(self);
+    if (state != NULL)
+        alsa_firewire_state_reset_stats(state);
+}
@@ -80,6 +80,10 @@ gboolean hitaki_alsa_firewire_unlock(HitakiAlsaFirewire *self, GError **error);
 gboolean hitaki_alsa_firewire_create_source(HitakiAlsaFirewire *self, GSource **source,
                                            GError **error);
 
+void hitaki_alsa_firewire_get_stats(HitakiAlsaFirewire *self, HitakiAlsaFirewireStats **stats);
+
+void hitaki_alsa_firewire_reset_stats(HitakiAlsaFirewire *self);
+
 G_END_DECLS
 
 #endif
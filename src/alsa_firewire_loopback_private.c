@@ -0,0 +1,367 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#include "alsa_firewire_private.h"
+
+#include <fcntl.h>
+#include <sys/socket.h>
+
+// The loopback backend emulates the character device of ALSA HwDep without any FireWire bus. The
+// file descriptor for the unit is one end of sequential packet socket pair so that both of
+// GSource and poll(2) work as usual, and each event is written into the other end as a packet.
+
+#define LOOPBACK_DEVICE_NAME        "loopback"
+
+// The same as the maximum size of frame in Fireworks transaction.
+#define MAXIMUM_EFW_FRAME_BYTES     0x200U
+
+struct loopback {
+    int peer;
+    gboolean is_locked;
+
+    GMutex lock;
+    struct snd_firewire_tascam_state tascam_state;
+    struct snd_firewire_motu_register_dsp_meter register_dsp_meter;
+    struct snd_firewire_motu_command_dsp_meter command_dsp_meter;
+    struct snd_firewire_motu_register_dsp_parameter register_dsp_parameter;
+};
+
+static const char *const type_names[] = {
+    [SNDRV_FIREWIRE_TYPE_DICE] = "dice",
+    [SNDRV_FIREWIRE_TYPE_FIREWORKS] = "fireworks",
+    [SNDRV_FIREWIRE_TYPE_BEBOB] = "bebob",
+    [SNDRV_FIREWIRE_TYPE_OXFW] = "oxfw",
+    [SNDRV_FIREWIRE_TYPE_DIGI00X] = "digi00x",
+    [SNDRV_FIREWIRE_TYPE_TASCAM] = "tascam",
+    [SNDRV_FIREWIRE_TYPE_MOTU] = "motu",
+    [SNDRV_FIREWIRE_TYPE_FIREFACE] = "fireface",
+};
+
+static unsigned int parse_type(const char *path)
+{
+    const char *name = path + strlen(LOOPBACK_PATH_PREFIX);
+    unsigned int i;
+
+    for (i = 0; i < G_N_ELEMENTS(type_names); ++i) {
+        if (type_names[i] != NULL && strcmp(name, type_names[i]) == 0)
+            return i;
+    }
+
+    return 0;
+}
+
+static int send_packet(struct loopback *loopback, const void *buf, size_t len)
+{
+    ssize_t result;
+
+    // The packet is dropped when the peer is congested, as the kernel driver does for the queue
+    // of events.
+    result = send(loopback->peer, buf, len, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (result < 0)
+        return -1;
+
+    return 0;
+}
+
+static void send_lock_status(struct loopback *loopback, gboolean is_locked)
+{
+    struct snd_firewire_event_lock_status event = {
+        .type = SNDRV_FIREWIRE_EVENT_LOCK_STATUS,
+        .status = is_locked,
+    };
+
+    send_packet(loopback, &event, sizeof(event));
+}
+
+static int change_lock(struct loopback *loopback, gboolean is_locked)
+{
+    int err = 0;
+
+    g_mutex_lock(&loopback->lock);
+    if (loopback->is_locked == is_locked)
+        err = is_locked ? EBUSY : EBADFD;
+    else
+        loopback->is_locked = is_locked;
+    g_mutex_unlock(&loopback->lock);
+
+    if (err > 0) {
+        errno = err;
+        return -1;
+    }
+
+    send_lock_status(loopback, is_locked);
+
+    return 0;
+}
+
+static int loopback_open(struct alsa_firewire_state *state, const char *path, int open_flag)
+{
+    struct loopback *loopback;
+    unsigned int type;
+    int fds[2];
+    int flags;
+
+    type = parse_type(path);
+    if (type == 0) {
+        errno = ENOENT;
+        return -1;
+    }
+
+    flags = SOCK_SEQPACKET | SOCK_CLOEXEC;
+    if (open_flag & O_NONBLOCK)
+        flags |= SOCK_NONBLOCK;
+    if (socketpair(AF_UNIX, flags, 0, fds) < 0)
+        return -1;
+
+    loopback = g_new0(struct loopback, 1);
+    loopback->peer = fds[1];
+    g_mutex_init(&loopback->lock);
+
+    // Keep the type in the emulated information since it is retrieved later by ioctl(2).
+    state->info.type = type;
+    state->backend_data = loopback;
+
+    return fds[0];
+}
+
+static void loopback_close(struct alsa_firewire_state *state)
+{
+    struct loopback *loopback = state->backend_data;
+
+    close(state->fd);
+
+    if (loopback != NULL) {
+        close(loopback->peer);
+        g_mutex_clear(&loopback->lock);
+        g_free(loopback);
+        state->backend_data = NULL;
+    }
+}
+
+static int copy_image(struct loopback *loopback, void *dst, const void *src, size_t size)
+{
+    g_mutex_lock(&loopback->lock);
+    memcpy(dst, src, size);
+    g_mutex_unlock(&loopback->lock);
+
+    return 0;
+}
+
+static int loopback_ioctl(struct alsa_firewire_state *state, unsigned long request, void *arg)
+{
+    struct loopback *loopback = state->backend_data;
+    unsigned int type = state->info.type;
+
+    switch (request) {
+    case SNDRV_FIREWIRE_IOCTL_GET_INFO:
+    {
+        struct snd_firewire_get_info *info = arg;
+
+        memset(info, 0, sizeof(*info));
+        info->type = type;
+        g_strlcpy(info->device_name, LOOPBACK_DEVICE_NAME, sizeof(info->device_name));
+        return 0;
+    }
+    case SNDRV_FIREWIRE_IOCTL_LOCK:
+    case SNDRV_FIREWIRE_IOCTL_UNLOCK:
+        return change_lock(loopback, request == SNDRV_FIREWIRE_IOCTL_LOCK);
+    case SNDRV_FIREWIRE_IOCTL_TASCAM_STATE:
+        if (type != SNDRV_FIREWIRE_TYPE_TASCAM)
+            break;
+        return copy_image(loopback, arg, &loopback->tascam_state,
+                          sizeof(loopback->tascam_state));
+    case SNDRV_FIREWIRE_IOCTL_MOTU_REGISTER_DSP_METER:
+        if (type != SNDRV_FIREWIRE_TYPE_MOTU)
+            break;
+        return copy_image(loopback, arg, &loopback->register_dsp_meter,
+                          sizeof(loopback->register_dsp_meter));
+    case SNDRV_FIREWIRE_IOCTL_MOTU_COMMAND_DSP_METER:
+        if (type != SNDRV_FIREWIRE_TYPE_MOTU)
+            break;
+        return copy_image(loopback, arg, &loopback->command_dsp_meter,
+                          sizeof(loopback->command_dsp_meter));
+    case SNDRV_FIREWIRE_IOCTL_MOTU_REGISTER_DSP_PARAMETER:
+        if (type != SNDRV_FIREWIRE_TYPE_MOTU)
+            break;
+        return copy_image(loopback, arg, &loopback->register_dsp_parameter,
+                          sizeof(loopback->register_dsp_parameter));
+    default:
+        break;
+    }
+
+    errno = ENOTTY;
+    return -1;
+}
+
+static ssize_t loopback_read(struct alsa_firewire_state *state, void *buf, size_t len)
+{
+    return read(state->fd, buf, len);
+}
+
+// The request frame of Fireworks transaction is answered immediately by the response frame with
+// successful status and the same parameters.
+static ssize_t loopback_write(struct alsa_firewire_state *state, const void *buf, size_t len)
+{
+    struct loopback *loopback = state->backend_data;
+    guint8 packet[sizeof(struct snd_firewire_event_efw_response) + MAXIMUM_EFW_FRAME_BYTES];
+    struct snd_firewire_event_efw_response *event = (void *)packet;
+    struct snd_efw_transaction *frame = (void *)event->response;
+
+    if (state->info.type != SNDRV_FIREWIRE_TYPE_FIREWORKS) {
+        errno = ENXIO;
+        return -1;
+    }
+
+    if (len < sizeof(*frame) || len > MAXIMUM_EFW_FRAME_BYTES) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    event->type = SNDRV_FIREWIRE_EVENT_EFW_RESPONSE;
+    memcpy(frame, buf, len);
+    frame->seqnum = GUINT32_TO_BE(GUINT32_FROM_BE(frame->seqnum) + 1);
+    frame->status = 0;
+
+    if (send_packet(loopback, packet, sizeof(*event) + len) < 0)
+        return -1;
+
+    return len;
+}
+
+const struct alsa_firewire_backend alsa_firewire_loopback_backend = {
+    .open = loopback_open,
+    .close = loopback_close,
+    .ioctl = loopback_ioctl,
+    .read = loopback_read,
+    .write = loopback_write,
+};
+
+static struct loopback *loopback_from_state(struct alsa_firewire_state *state, GError **error)
+{
+    if (state->fd < 0) {
+        generate_alsa_firewire_error(error, HITAKI_ALSA_FIREWIRE_ERROR_IS_NOT_OPENED);
+        return NULL;
+    }
+
+    if (state->backend != &alsa_firewire_loopback_backend) {
+        generate_alsa_firewire_error(error, HITAKI_ALSA_FIREWIRE_ERROR_WRONG_CLASS);
+        return NULL;
+    }
+
+    return state->backend_data;
+}
+
+// Deliver the given event to the unit as if the kernel driver queued it.
+gboolean alsa_firewire_loopback_inject_event(struct alsa_firewire_state *state,
+                                             const union snd_firewire_event *event, size_t length,
+                                             GError **error)
+{
+    struct loopback *loopback;
+
+    g_return_val_if_fail(event != NULL && length >= sizeof(event->common), FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    loopback = loopback_from_state(state, error);
+    if (loopback == NULL)
+        return FALSE;
+
+    if (send_packet(loopback, event, length) < 0) {
+        generate_alsa_firewire_syscall_error(error, errno, "send(%s)", "loopback");
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+// Replace the emulated image retrieved by the request of ioctl(2). The change of TASCAM state is
+// notified by the event as the kernel driver does.
+gboolean alsa_firewire_loopback_update(struct alsa_firewire_state *state, unsigned long request,
+                                       const void *data, size_t size, GError **error)
+{
+    struct loopback *loopback;
+    void *image;
+    size_t image_size;
+
+    g_return_val_if_fail(data != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    loopback = loopback_from_state(state, error);
+    if (loopback == NULL)
+        return FALSE;
+
+    switch (request) {
+    case SNDRV_FIREWIRE_IOCTL_TASCAM_STATE:
+        image = &loopback->tascam_state;
+        image_size = sizeof(loopback->tascam_state);
+        break;
+    case SNDRV_FIREWIRE_IOCTL_MOTU_REGISTER_DSP_METER:
+        image = &loopback->register_dsp_meter;
+        image_size = sizeof(loopback->register_dsp_meter);
+        break;
+    case SNDRV_FIREWIRE_IOCTL_MOTU_COMMAND_DSP_METER:
+        image = &loopback->command_dsp_meter;
+        image_size = sizeof(loopback->command_dsp_meter);
+        break;
+    case SNDRV_FIREWIRE_IOCTL_MOTU_REGISTER_DSP_PARAMETER:
+        image = &loopback->register_dsp_parameter;
+        image_size = sizeof(loopback->register_dsp_parameter);
+        break;
+    default:
+        generate_alsa_firewire_syscall_error(error, ENOTTY, "ioctl(%lu)", request);
+        return FALSE;
+    }
+
+    g_return_val_if_fail(size == image_size, FALSE);
+
+    if (request == SNDRV_FIREWIRE_IOCTL_TASCAM_STATE) {
+        const struct snd_firewire_tascam_state *next = data;
+        guint8 packet[sizeof(struct snd_firewire_event_tascam_control) +
+                      sizeof(struct snd_firewire_tascam_change) *
+                      SNDRV_FIREWIRE_TASCAM_STATE_COUNT];
+        struct snd_firewire_event_tascam_control *event = (void *)packet;
+        unsigned int count = 0;
+        int i;
+
+        g_mutex_lock(&loopback->lock);
+        for (i = 0; i < SNDRV_FIREWIRE_TASCAM_STATE_COUNT; ++i) {
+            if (loopback->tascam_state.data[i] == next->data[i])
+                continue;
+            event->changes[count].index = i;
+            event->changes[count].before = loopback->tascam_state.data[i];
+            event->changes[count].after = next->data[i];
+            ++count;
+        }
+        memcpy(image, data, size);
+        g_mutex_unlock(&loopback->lock);
+
+        if (count > 0) {
+            event->type = SNDRV_FIREWIRE_EVENT_TASCAM_CONTROL;
+            send_packet(loopback, packet,
+                        sizeof(*event) + sizeof(event->changes[0]) * count);
+        }
+    } else {
+        g_mutex_lock(&loopback->lock);
+        memcpy(image, data, size);
+        g_mutex_unlock(&loopback->lock);
+    }
+
+    return TRUE;
+}
+
+// Shut down the other end so that the unit reads the end of file after the queued events, as if
+// the character device were released.
+gboolean alsa_firewire_loopback_hang_up(struct alsa_firewire_state *state, GError **error)
+{
+    struct loopback *loopback;
+
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    loopback = loopback_from_state(state, error);
+    if (loopback == NULL)
+        return FALSE;
+
+    if (shutdown(loopback->peer, SHUT_WR) < 0) {
+        generate_alsa_firewire_syscall_error(error, errno, "shutdown(%s)", "loopback");
+        return FALSE;
+    }
+
+    return TRUE;
+}
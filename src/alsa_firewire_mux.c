@@ -0,0 +1,759 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#define _GNU_SOURCE
+#include "alsa_firewire_private.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+/**
+ * HitakiAlsaFirewireMux:
+ * A GObject-derived object to multiplex events from several sound units.
+ *
+ * The [class@AlsaFirewireMux] is an object class derived from [class@GObject.Object] to handle
+ * events from several ALSA HwDep character devices by one [struct@GLib.Source]. The source watches
+ * all of file descriptors for the added units, reads events into one buffer shared by the units,
+ * then dispatches them to the unit associated to the file descriptor. It is convenient to handle
+ * events for many units in one thread, instead of the source per unit retrieved by
+ * [method@AlsaFirewire.create_source].
+ *
+ * The unit should be an instance of the object class implemented in this library.
+ *
+ * The object can also run the source in the thread owned by this library with its own
+ * [struct@GLib.MainContext], so that the latency to handle events does not depend on the other
+ * sources in the main context of application. The events are handled in the thread, or handed off
+ * to the other main context via lock-free queue.
+ */
+
+struct handoff_source;
+
+struct mux_thread {
+    GThread *thread;
+    GMainContext *context;
+    GMainLoop *loop;
+    GSource *source;
+    struct handoff_source *handoff;
+
+    gint priority;
+    gint cpu;
+
+    // For the result of scheduling parameters applied in the thread.
+    GMutex mutex;
+    GCond cond;
+    gboolean is_started;
+    int err;
+    const char *label;
+};
+
+typedef struct {
+    GMutex lock;
+    GPtrArray *units;
+    GList *sources;
+
+    struct mux_thread *thread;
+} HitakiAlsaFirewireMuxPrivate;
+
+G_DEFINE_TYPE_WITH_PRIVATE(HitakiAlsaFirewireMux, hitaki_alsa_firewire_mux, G_TYPE_OBJECT)
+
+typedef struct {
+    GSource src;
+    HitakiAlsaFirewireMux *mux;
+    // The key is the unit, and the value is the tag for its file descriptor.
+    GHashTable *tags;
+    void *buf;
+    size_t len;
+    struct handoff_source *handoff;
+} AlsaFirewireMuxSource;
+
+// The queue of records with variable length for single producer and single consumer. The records
+// are aligned to 8 bytes, and the record never wraps around the end of buffer.
+#define HANDOFF_BUFFER_SIZE     (256 * 1024)
+#define HANDOFF_RECORD_ALIGN    8
+
+enum handoff_record_type {
+    HANDOFF_RECORD_EVENT = 0,
+    HANDOFF_RECORD_DISCONNECTION,
+    HANDOFF_RECORD_PADDING,
+};
+
+struct handoff_record {
+    HitakiAlsaFirewire *unit;
+    gint64 dispatch_time;
+    guint32 type;
+    guint32 length;
+    guint8 payload[];
+};
+
+#define HANDOFF_RECORD_SIZE(length)                                                     \
+    ((sizeof(struct handoff_record) + (length) + HANDOFF_RECORD_ALIGN - 1) &            \
+     ~(HANDOFF_RECORD_ALIGN - 1))
+
+struct handoff_source {
+    GSource src;
+    guint8 *buf;
+    guint size;
+    // Written by the producer.
+    guint head;
+    // Written by the consumer.
+    guint tail;
+};
+
+struct mux_ready {
+    HitakiAlsaFirewire *unit;
+    GIOCondition condition;
+};
+
+static void alsa_firewire_mux_finalize(GObject *obj)
+{
+    HitakiAlsaFirewireMux *self = HITAKI_ALSA_FIREWIRE_MUX(obj);
+    HitakiAlsaFirewireMuxPrivate *priv = hitaki_alsa_firewire_mux_get_instance_private(self);
+
+    g_ptr_array_unref(priv->units);
+    g_mutex_clear(&priv->lock);
+
+    G_OBJECT_CLASS(hitaki_alsa_firewire_mux_parent_class)->finalize(obj);
+}
+
+static void hitaki_alsa_firewire_mux_class_init(HitakiAlsaFirewireMuxClass *klass)
+{
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+
+    gobject_class->finalize = alsa_firewire_mux_finalize;
+}
+
+static void hitaki_alsa_firewire_mux_init(HitakiAlsaFirewireMux *self)
+{
+    HitakiAlsaFirewireMuxPrivate *priv = hitaki_alsa_firewire_mux_get_instance_private(self);
+
+    g_mutex_init(&priv->lock);
+    priv->units = g_ptr_array_new_with_free_func(g_object_unref);
+    priv->sources = NULL;
+}
+
+/**
+ * hitaki_alsa_firewire_mux_new:
+ *
+ * Instantiate [class@AlsaFirewireMux] object and return it.
+ *
+ * Returns: an instance of [class@AlsaFirewireMux].
+ */
+HitakiAlsaFirewireMux *hitaki_alsa_firewire_mux_new(void)
+{
+    return g_object_new(HITAKI_TYPE_ALSA_FIREWIRE_MUX, NULL);
+}
+
+static gboolean has_unit(const GPtrArray *units, HitakiAlsaFirewire *unit)
+{
+    int i;
+
+    for (i = 0; i < units->len; ++i) {
+        if (g_ptr_array_index(units, i) == unit)
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+// The source is not available anymore after destroyed, while it is still in the list till
+// finalized.
+static void watch_unit(AlsaFirewireMuxSource *src, HitakiAlsaFirewire *unit,
+                       const struct alsa_firewire_state *state)
+{
+    GSource *source = (GSource *)src;
+
+    if (!g_source_is_destroyed(source)) {
+        gpointer tag = g_source_add_unix_fd(source, state->fd, G_IO_IN);
+        g_hash_table_insert(src->tags, unit, tag);
+    }
+}
+
+static void unwatch_unit(AlsaFirewireMuxSource *src, HitakiAlsaFirewire *unit)
+{
+    GSource *source = (GSource *)src;
+    gpointer tag;
+
+    tag = g_hash_table_lookup(src->tags, unit);
+    if (tag != NULL) {
+        if (!g_source_is_destroyed(source))
+            g_source_remove_unix_fd(source, tag);
+        g_hash_table_remove(src->tags, unit);
+    }
+}
+
+// Stop watching the unit in all of sources, then release the reference to the unit. The caller
+// should hold the lock.
+static void drop_unit(HitakiAlsaFirewireMuxPrivate *priv, HitakiAlsaFirewire *unit)
+{
+    GList *entry;
+
+    if (has_unit(priv->units, unit)) {
+        for (entry = priv->sources; entry != NULL; entry = entry->next)
+            unwatch_unit(entry->data, unit);
+        g_ptr_array_remove(priv->units, unit);
+    }
+}
+
+/**
+ * hitaki_alsa_firewire_mux_add_unit:
+ * @self: A [class@AlsaFirewireMux].
+ * @unit: A [iface@AlsaFirewire] associated to ALSA HwDep character device.
+ * @error: A [struct@GLib.Error].
+ *
+ * Add the unit so that the sources retrieved by [method@AlsaFirewireMux.create_source] handle
+ * events from the associated ALSA HwDep character device. The object keeps the reference to the
+ * unit till [method@AlsaFirewireMux.remove_unit] is called, or till the associated character
+ * device is unavailable. Nothing happens when the unit is already added.
+ *
+ * Returns: TRUE if the overall operation finished successfully, else FALSE.
+ */
+gboolean hitaki_alsa_firewire_mux_add_unit(HitakiAlsaFirewireMux *self, HitakiAlsaFirewire *unit,
+                                           GError **error)
+{
+    HitakiAlsaFirewireMuxPrivate *priv;
+    struct alsa_firewire_state *state;
+    gboolean is_added = FALSE;
+    GList *entry;
+
+    g_return_val_if_fail(HITAKI_IS_ALSA_FIREWIRE_MUX(self), FALSE);
+    g_return_val_if_fail(HITAKI_IS_ALSA_FIREWIRE(unit), FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    priv = hitaki_alsa_firewire_mux_get_instance_private(self);
+
+    state = alsa_firewire_state_from_unit(unit);
+    if (state == NULL) {
+        generate_alsa_firewire_error(error, HITAKI_ALSA_FIREWIRE_ERROR_WRONG_CLASS);
+        return FALSE;
+    }
+
+    if (state->fd < 0) {
+        generate_alsa_firewire_error(error, HITAKI_ALSA_FIREWIRE_ERROR_IS_NOT_OPENED);
+        return FALSE;
+    }
+
+    g_mutex_lock(&priv->lock);
+    if (!has_unit(priv->units, unit)) {
+        g_ptr_array_add(priv->units, g_object_ref(unit));
+        for (entry = priv->sources; entry != NULL; entry = entry->next)
+            watch_unit(entry->data, unit, state);
+        is_added = TRUE;
+    }
+    g_mutex_unlock(&priv->lock);
+
+    if (is_added)
+        alsa_firewire_state_check_lock(state);
+
+    return TRUE;
+}
+
+/**
+ * hitaki_alsa_firewire_mux_remove_unit:
+ * @self: A [class@AlsaFirewireMux].
+ * @unit: A [iface@AlsaFirewire] added by [method@AlsaFirewireMux.add_unit].
+ *
+ * Remove the unit so that the sources retrieved by [method@AlsaFirewireMux.create_source] stop
+ * handling events from the associated ALSA HwDep character device, then release the reference to
+ * the unit.
+ */
+void hitaki_alsa_firewire_mux_remove_unit(HitakiAlsaFirewireMux *self, HitakiAlsaFirewire *unit)
+{
+    HitakiAlsaFirewireMuxPrivate *priv;
+
+    g_return_if_fail(HITAKI_IS_ALSA_FIREWIRE_MUX(self));
+    g_return_if_fail(HITAKI_IS_ALSA_FIREWIRE(unit));
+
+    priv = hitaki_alsa_firewire_mux_get_instance_private(self);
+
+    // The last reference can be released outside of the critical section.
+    g_object_ref(unit);
+
+    g_mutex_lock(&priv->lock);
+    drop_unit(priv, unit);
+    g_mutex_unlock(&priv->lock);
+
+    g_object_unref(unit);
+}
+
+static gboolean dispatch_handoff(GSource *source, GSourceFunc cb, gpointer user_data)
+{
+    struct handoff_source *handoff = (struct handoff_source *)source;
+    guint head, tail;
+
+    // The producer wakes up the source again for the records pushed after the check of head.
+    g_source_set_ready_time(source, -1);
+
+    head = g_atomic_int_get(&handoff->head);
+    tail = handoff->tail;
+    while (tail != head) {
+        guint offset = tail & (handoff->size - 1);
+        const struct handoff_record *record;
+
+        if (handoff->size - offset < sizeof(*record)) {
+            tail += handoff->size - offset;
+            continue;
+        }
+
+        record = (const struct handoff_record *)(handoff->buf + offset);
+        if (record->type == HANDOFF_RECORD_PADDING) {
+            tail += handoff->size - offset;
+            continue;
+        }
+
+        if (record->type == HANDOFF_RECORD_EVENT) {
+            alsa_firewire_state_handle_event(alsa_firewire_state_from_unit(record->unit),
+                                             (const union snd_firewire_event *)record->payload,
+                                             record->length, record->dispatch_time);
+        } else {
+            alsa_firewire_state_handle_disconnection(alsa_firewire_state_from_unit(record->unit));
+        }
+        g_object_unref(record->unit);
+
+        tail += HANDOFF_RECORD_SIZE(record->length);
+        g_atomic_int_set(&handoff->tail, tail);
+    }
+
+    return G_SOURCE_CONTINUE;
+}
+
+static void finalize_handoff(GSource *source)
+{
+    struct handoff_source *handoff = (struct handoff_source *)source;
+    guint head, tail;
+
+    // Release the units in the records left undelivered.
+    head = g_atomic_int_get(&handoff->head);
+    tail = handoff->tail;
+    while (tail != head) {
+        guint offset = tail & (handoff->size - 1);
+        const struct handoff_record *record;
+
+        if (handoff->size - offset < sizeof(*record)) {
+            tail += handoff->size - offset;
+            continue;
+        }
+
+        record = (const struct handoff_record *)(handoff->buf + offset);
+        if (record->type == HANDOFF_RECORD_PADDING) {
+            tail += handoff->size - offset;
+            continue;
+        }
+
+        g_object_unref(record->unit);
+        tail += HANDOFF_RECORD_SIZE(record->length);
+    }
+
+    g_free(handoff->buf);
+}
+
+static struct handoff_source *create_handoff_source(void)
+{
+    static GSourceFuncs funcs = {
+        .dispatch   = dispatch_handoff,
+        .finalize   = finalize_handoff,
+    };
+    struct handoff_source *handoff;
+    GSource *source;
+
+    source = g_source_new(&funcs, sizeof(struct handoff_source));
+    g_source_set_name(source, "HitakiAlsaFirewireMuxHandoff");
+
+    handoff = (struct handoff_source *)source;
+    handoff->size = HANDOFF_BUFFER_SIZE;
+    handoff->buf = g_malloc(handoff->size);
+    handoff->head = 0;
+    handoff->tail = 0;
+
+    return handoff;
+}
+
+// Never blocks. The record is discarded when the queue is full.
+static void push_handoff_record(struct handoff_source *handoff, enum handoff_record_type type,
+                                struct alsa_firewire_state *state, const void *payload,
+                                size_t length)
+{
+    struct handoff_record *record;
+    guint head, tail, offset, padding, size;
+
+    size = HANDOFF_RECORD_SIZE(length);
+    if (size > handoff->size)
+        return;
+
+    head = handoff->head;
+    tail = g_atomic_int_get(&handoff->tail);
+
+    offset = head & (handoff->size - 1);
+    padding = 0;
+    if (handoff->size - offset < size)
+        padding = handoff->size - offset;
+
+    if (handoff->size - (head - tail) < padding + size)
+        return;
+
+    if (padding >= sizeof(*record)) {
+        record = (struct handoff_record *)(handoff->buf + offset);
+        record->type = HANDOFF_RECORD_PADDING;
+    }
+    head += padding;
+
+    record = (struct handoff_record *)(handoff->buf + (head & (handoff->size - 1)));
+    record->unit = g_object_ref(state->unit);
+    record->dispatch_time = state->dispatch_time;
+    record->type = type;
+    record->length = length;
+    if (length > 0)
+        memcpy(record->payload, payload, length);
+
+    g_atomic_int_set(&handoff->head, head + size);
+}
+
+static void push_handoff_event(struct alsa_firewire_state *state,
+                               const union snd_firewire_event *event, size_t length,
+                               gpointer user_data)
+{
+    struct handoff_source *handoff = (struct handoff_source *)user_data;
+
+    push_handoff_record(handoff, HANDOFF_RECORD_EVENT, state, event, length);
+}
+
+static gboolean handoff_events(struct handoff_source *handoff, struct alsa_firewire_state *state,
+                               GIOCondition condition, gint64 dispatch_time, void *buf,
+                               size_t len)
+{
+    if (condition & G_IO_ERR) {
+        push_handoff_record(handoff, HANDOFF_RECORD_DISCONNECTION, state, NULL, 0);
+        return FALSE;
+    }
+
+    // The latency till the handler includes the wait for the thread of handoff source.
+    state->dispatch_time = dispatch_time;
+
+    return alsa_firewire_state_read_events(state, buf, len, push_handoff_event, handoff);
+}
+
+static gboolean check_src(GSource *source)
+{
+    AlsaFirewireMuxSource *src = (AlsaFirewireMuxSource *)source;
+    HitakiAlsaFirewireMuxPrivate *priv = hitaki_alsa_firewire_mux_get_instance_private(src->mux);
+    gboolean is_ready = FALSE;
+    GHashTableIter iter;
+    gpointer tag;
+
+    // Don't go to dispatch if nothing available. As an error, return TRUE for POLLERR to call
+    // .dispatch for internal destruction.
+    g_mutex_lock(&priv->lock);
+    g_hash_table_iter_init(&iter, src->tags);
+    while (g_hash_table_iter_next(&iter, NULL, &tag)) {
+        if (g_source_query_unix_fd(source, tag) & (G_IO_IN | G_IO_ERR)) {
+            is_ready = TRUE;
+            break;
+        }
+    }
+    g_mutex_unlock(&priv->lock);
+
+    return is_ready;
+}
+
+static gboolean dispatch_src(GSource *source, GSourceFunc cb, gpointer user_data)
+{
+    AlsaFirewireMuxSource *src = (AlsaFirewireMuxSource *)source;
+    HitakiAlsaFirewireMuxPrivate *priv = hitaki_alsa_firewire_mux_get_instance_private(src->mux);
+    struct mux_ready *readies;
+    unsigned int count;
+    GHashTableIter iter;
+    gpointer unit, tag;
+    gint64 dispatch_time;
+    int i;
+
+    // The units are handled outside of the critical section since the handlers of signals can
+    // add or remove units.
+    g_mutex_lock(&priv->lock);
+    readies = g_newa(struct mux_ready, g_hash_table_size(src->tags));
+    count = 0;
+    g_hash_table_iter_init(&iter, src->tags);
+    while (g_hash_table_iter_next(&iter, &unit, &tag)) {
+        GIOCondition condition = g_source_query_unix_fd(source, tag);
+
+        if (condition & (G_IO_IN | G_IO_ERR)) {
+            readies[count].unit = g_object_ref(unit);
+            readies[count].condition = condition;
+            ++count;
+        }
+    }
+    g_mutex_unlock(&priv->lock);
+
+    dispatch_time = g_source_get_time(source);
+    for (i = 0; i < count; ++i) {
+        struct alsa_firewire_state *state = alsa_firewire_state_from_unit(readies[i].unit);
+        gboolean is_available;
+
+        if (src->handoff != NULL)
+            is_available = handoff_events(src->handoff, state, readies[i].condition,
+                                          dispatch_time, src->buf, src->len);
+        else
+            is_available = alsa_firewire_state_dispatch(state, readies[i].condition,
+                                                        dispatch_time, src->buf, src->len);
+
+        if (!is_available) {
+            // The unit is not available anymore. Remove it from all of sources so that it can be
+            // added again after reopened.
+            g_mutex_lock(&priv->lock);
+            drop_unit(priv, readies[i].unit);
+            g_mutex_unlock(&priv->lock);
+        }
+
+        g_object_unref(readies[i].unit);
+    }
+
+    if (src->handoff != NULL && count > 0)
+        g_source_set_ready_time(&src->handoff->src, 0);
+
+    return G_SOURCE_CONTINUE;
+}
+
+static void finalize_src(GSource *source)
+{
+    AlsaFirewireMuxSource *src = (AlsaFirewireMuxSource *)source;
+    HitakiAlsaFirewireMuxPrivate *priv = hitaki_alsa_firewire_mux_get_instance_private(src->mux);
+
+    g_mutex_lock(&priv->lock);
+    priv->sources = g_list_remove(priv->sources, src);
+    g_mutex_unlock(&priv->lock);
+
+    g_hash_table_unref(src->tags);
+    g_free(src->buf);
+    g_object_unref(src->mux);
+}
+
+static GSource *create_mux_source(HitakiAlsaFirewireMux *self, struct handoff_source *handoff)
+{
+    static GSourceFuncs funcs = {
+        .check      = check_src,
+        .dispatch   = dispatch_src,
+        .finalize   = finalize_src,
+    };
+    HitakiAlsaFirewireMuxPrivate *priv = hitaki_alsa_firewire_mux_get_instance_private(self);
+    AlsaFirewireMuxSource *src;
+    GSource *source;
+    int i;
+
+    source = g_source_new(&funcs, sizeof(AlsaFirewireMuxSource));
+
+    g_source_set_name(source, "HitakiAlsaFirewireMux");
+
+    // MEMO: allocate one page because we cannot assume the size of data.
+    src = (AlsaFirewireMuxSource *)source;
+    src->len = sysconf(_SC_PAGESIZE);
+    src->buf = g_malloc(src->len);
+
+    src->mux = g_object_ref(self);
+    src->tags = g_hash_table_new(g_direct_hash, g_direct_equal);
+    src->handoff = handoff;
+
+    g_mutex_lock(&priv->lock);
+    for (i = 0; i < priv->units->len; ++i) {
+        HitakiAlsaFirewire *unit = g_ptr_array_index(priv->units, i);
+
+        watch_unit(src, unit, alsa_firewire_state_from_unit(unit));
+    }
+    priv->sources = g_list_prepend(priv->sources, src);
+    g_mutex_unlock(&priv->lock);
+
+    return source;
+}
+
+/**
+ * hitaki_alsa_firewire_mux_create_source:
+ * @self: A [class@AlsaFirewireMux].
+ * @source: (out): A [struct@GLib.Source] to handle events from ALSA HwDep character devices.
+ * @error: A [struct@GLib.Error].
+ *
+ * Allocate [struct@GLib.Source] to handle events from ALSA HwDep character devices associated to
+ * the added units. The units added or removed later are also handled by the source or not.
+ *
+ * Returns: TRUE if the overall operation finished successfully, else FALSE.
+ */
+gboolean hitaki_alsa_firewire_mux_create_source(HitakiAlsaFirewireMux *self, GSource **source,
+                                                GError **error)
+{
+    g_return_val_if_fail(HITAKI_IS_ALSA_FIREWIRE_MUX(self), FALSE);
+    g_return_val_if_fail(source != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    *source = create_mux_source(self, NULL);
+
+    return TRUE;
+}
+
+static void release_thread(struct mux_thread *th)
+{
+    g_source_destroy(th->source);
+    g_source_unref(th->source);
+
+    if (th->handoff != NULL) {
+        g_source_destroy(&th->handoff->src);
+        g_source_unref(&th->handoff->src);
+    }
+
+    g_main_loop_unref(th->loop);
+    g_main_context_unref(th->context);
+
+    g_cond_clear(&th->cond);
+    g_mutex_clear(&th->mutex);
+    g_free(th);
+}
+
+static gpointer run_thread(gpointer data)
+{
+    struct mux_thread *th = (struct mux_thread *)data;
+    const char *label = NULL;
+    int err = 0;
+
+    if (th->cpu >= 0) {
+        cpu_set_t set;
+
+        CPU_ZERO(&set);
+        CPU_SET(th->cpu, &set);
+        err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        label = "pthread_setaffinity_np";
+    }
+
+    if (err == 0 && th->priority > 0) {
+        struct sched_param param = {
+            .sched_priority = th->priority,
+        };
+
+        err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        label = "pthread_setschedparam";
+    }
+
+    g_mutex_lock(&th->mutex);
+    th->err = err;
+    th->label = label;
+    th->is_started = TRUE;
+    g_cond_signal(&th->cond);
+    g_mutex_unlock(&th->mutex);
+
+    if (err != 0)
+        return NULL;
+
+    g_main_context_push_thread_default(th->context);
+    g_main_loop_run(th->loop);
+    g_main_context_pop_thread_default(th->context);
+
+    return NULL;
+}
+
+static gboolean quit_loop(gpointer user_data)
+{
+    g_main_loop_quit((GMainLoop *)user_data);
+
+    return G_SOURCE_REMOVE;
+}
+
+/**
+ * hitaki_alsa_firewire_mux_start_thread:
+ * @self: A [class@AlsaFirewireMux].
+ * @priority: The priority of thread for `SCHED_FIFO` scheduling policy. The thread is scheduled
+ *            by the default policy when the value is zero.
+ * @cpu: The index of CPU core to which the thread is bound. The thread is not bound when the
+ *       value is negative.
+ * @delivery_context: (nullable): A [struct@GLib.MainContext] to which the events are handed off,
+ *                    or NULL to handle them in the thread.
+ * @error: A [struct@GLib.Error].
+ *
+ * Start the thread owned by this library to handle events from ALSA HwDep character devices
+ * associated to the added units. The thread runs its own [struct@GLib.MainContext] with the
+ * source retrieved by [method@AlsaFirewireMux.create_source]. When the delivery context is given,
+ * the events are handed off via lock-free queue to the source attached to the context, and
+ * handled in the thread iterating the context. The events are discarded when the queue is full.
+ * The thread keeps the reference to the object till [method@AlsaFirewireMux.stop_thread] is
+ * called.
+ *
+ * Returns: TRUE if the overall operation finished successfully, else FALSE.
+ */
+gboolean hitaki_alsa_firewire_mux_start_thread(HitakiAlsaFirewireMux *self, gint priority,
+                                               gint cpu, GMainContext *delivery_context,
+                                               GError **error)
+{
+    HitakiAlsaFirewireMuxPrivate *priv;
+    struct mux_thread *th;
+
+    g_return_val_if_fail(HITAKI_IS_ALSA_FIREWIRE_MUX(self), FALSE);
+    g_return_val_if_fail(priority >= 0, FALSE);
+    g_return_val_if_fail(cpu < CPU_SETSIZE, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    priv = hitaki_alsa_firewire_mux_get_instance_private(self);
+    g_return_val_if_fail(priv->thread == NULL, FALSE);
+
+    th = g_new0(struct mux_thread, 1);
+    th->priority = priority;
+    th->cpu = cpu;
+    g_mutex_init(&th->mutex);
+    g_cond_init(&th->cond);
+
+    th->context = g_main_context_new();
+    th->loop = g_main_loop_new(th->context, FALSE);
+
+    if (delivery_context != NULL) {
+        th->handoff = create_handoff_source();
+        g_source_attach(&th->handoff->src, delivery_context);
+    }
+
+    th->source = create_mux_source(self, th->handoff);
+    g_source_attach(th->source, th->context);
+
+    th->thread = g_thread_try_new("hitaki-mux", run_thread, th, error);
+    if (th->thread == NULL) {
+        release_thread(th);
+        return FALSE;
+    }
+
+    g_mutex_lock(&th->mutex);
+    while (!th->is_started)
+        g_cond_wait(&th->cond, &th->mutex);
+    g_mutex_unlock(&th->mutex);
+
+    if (th->err != 0) {
+        g_thread_join(th->thread);
+        generate_alsa_firewire_syscall_error(error, th->err, "%s()", th->label);
+        release_thread(th);
+        return FALSE;
+    }
+
+    priv->thread = th;
+
+    return TRUE;
+}
+
+/**
+ * hitaki_alsa_firewire_mux_stop_thread:
+ * @self: A [class@AlsaFirewireMux].
+ *
+ * Stop the thread started by [method@AlsaFirewireMux.start_thread], then release the sources
+ * used by the thread. Nothing happens when the thread is not running.
+ */
+void hitaki_alsa_firewire_mux_stop_thread(HitakiAlsaFirewireMux *self)
+{
+    HitakiAlsaFirewireMuxPrivate *priv;
+    struct mux_thread *th;
+    GSource *source;
+
+    g_return_if_fail(HITAKI_IS_ALSA_FIREWIRE_MUX(self));
+
+    priv = hitaki_alsa_firewire_mux_get_instance_private(self);
+
+    th = priv->thread;
+    if (th == NULL)
+        return;
+    priv->thread = NULL;
+
+    // The request to quit is queued so that it is not lost even if the loop does not run yet.
+    source = g_idle_source_new();
+    g_source_set_callback(source, quit_loop, th->loop, NULL);
+    g_source_attach(source, th->context);
+    g_source_unref(source);
+
+    g_thread_join(th->thread);
+
+    release_thread(th);
+}
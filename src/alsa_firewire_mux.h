@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#ifndef __HITAKI_ALSA_FIREWIRE_MUX_H__
+#define __HITAKI_ALSA_FIREWIRE_MUX_H__
+
+#include <hitaki.h>
+
+G_BEGIN_DECLS
+
+#define HITAKI_TYPE_ALSA_FIREWIRE_MUX   (hitaki_alsa_firewire_mux_get_type())
+
+G_DECLARE_DERIVABLE_TYPE(HitakiAlsaFirewireMux, hitaki_alsa_firewire_mux, HITAKI,
+                         ALSA_FIREWIRE_MUX, GObject);
+
+struct _HitakiAlsaFirewireMuxClass {
+    GObjectClass parent_class;
+};
+
+HitakiAlsaFirewireMux *hitaki_alsa_firewire_mux_new(void);
+
+gboolean hitaki_alsa_firewire_mux_add_unit(HitakiAlsaFirewireMux *self, HitakiAlsaFirewire *unit,
+                                           GError **error);
+
+void hitaki_alsa_firewire_mux_remove_unit(HitakiAlsaFirewireMux *self, HitakiAlsaFirewire *unit);
+
+gboolean hitaki_alsa_firewire_mux_create_source(HitakiAlsaFirewireMux *self, GSource **source,
+                                                GError **error);
+
+gboolean hitaki_alsa_firewire_mux_start_thread(HitakiAlsaFirewireMux *self, gint priority,
+                                               gint cpu, GMainContext *delivery_context,
+                                               GError **error);
+
+void hitaki_alsa_firewire_mux_stop_thread(HitakiAlsaFirewireMux *self);
+
+G_END_DECLS
+
+#endif
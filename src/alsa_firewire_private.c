@@ -1,21 +1,64 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 #include "alsa_firewire_private.h"
+#include "event_ring_private.h"
+#include "trace_private.h"
 
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <poll.h>
 
 typedef struct {
     GSource src;
-    int fd;
-    HitakiAlsaFirewire *unit;
+    struct alsa_firewire_state *state;
     gpointer tag;
     void *buf;
     size_t len;
-    void (*handle_event)(HitakiAlsaFirewire *self, const union snd_firewire_event *event,
-                         size_t length);
 } AlsaFirewireSource;
 
+static int kernel_open(struct alsa_firewire_state *state, const char *path, int open_flag)
+{
+    return open(path, open_flag);
+}
+
+static void kernel_close(struct alsa_firewire_state *state)
+{
+    close(state->fd);
+}
+
+static int kernel_ioctl(struct alsa_firewire_state *state, unsigned long request, void *arg)
+{
+    return ioctl(state->fd, request, arg);
+}
+
+static ssize_t kernel_read(struct alsa_firewire_state *state, void *buf, size_t len)
+{
+    return read(state->fd, buf, len);
+}
+
+static ssize_t kernel_write(struct alsa_firewire_state *state, const void *buf, size_t len)
+{
+    return write(state->fd, buf, len);
+}
+
+const struct alsa_firewire_backend alsa_firewire_kernel_backend = {
+    .open = kernel_open,
+    .close = kernel_close,
+    .ioctl = kernel_ioctl,
+    .read = kernel_read,
+    .write = kernel_write,
+};
+
+static GQuark alsa_firewire_state_quark(void)
+{
+    return g_quark_from_static_string("hitaki-alsa-firewire-state");
+}
+
+static GQuark alsa_firewire_event_ring_quark(void)
+{
+    return g_quark_from_static_string("hitaki-alsa-firewire-event-ring");
+}
+
 void alsa_firewire_class_override_properties(GObjectClass *gobject_class)
 {
     g_object_class_override_property(gobject_class,
@@ -30,6 +73,10 @@ void alsa_firewire_class_override_properties(GObjectClass *gobject_class)
                                      ALSA_FIREWIRE_PROP_GUID, GUID_PROP_NAME);
     g_object_class_override_property(gobject_class,
                                      ALSA_FIREWIRE_PROP_IS_DISCONNECTED, IS_DISCONNECTED_PROP_NAME);
+    g_object_class_override_property(gobject_class,
+                                     ALSA_FIREWIRE_PROP_DISPATCH_BUDGET, DISPATCH_BUDGET_PROP_NAME);
+    g_object_class_override_property(gobject_class,
+                                     ALSA_FIREWIRE_PROP_EVENT_RING, EVENT_RING_PROP_NAME);
 }
 
 void alsa_firewire_state_set_property(struct alsa_firewire_state *state, GObject *self, guint id,
@@ -42,6 +89,15 @@ void alsa_firewire_state_set_property(struct alsa_firewire_state *state, GObject
     case ALSA_FIREWIRE_PROP_IS_DISCONNECTED:
         state->is_disconnected = g_value_get_boolean(val);
         break;
+    case ALSA_FIREWIRE_PROP_DISPATCH_BUDGET:
+        state->dispatch_budget = g_value_get_uint(val);
+        break;
+    case ALSA_FIREWIRE_PROP_EVENT_RING:
+        // The reference is owned by the instance, and released at finalization.
+        state->event_ring = g_value_dup_object(val);
+        g_object_set_qdata_full(self, alsa_firewire_event_ring_quark(), state->event_ring,
+                                g_object_unref);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(self, id, spec);
         break;
@@ -70,23 +126,50 @@ void alsa_firewire_state_get_property(const struct alsa_firewire_state *state, G
     case ALSA_FIREWIRE_PROP_IS_DISCONNECTED:
         g_value_set_boolean(val, state->is_disconnected);
         break;
+    case ALSA_FIREWIRE_PROP_DISPATCH_BUDGET:
+        g_value_set_uint(val, state->dispatch_budget);
+        break;
+    case ALSA_FIREWIRE_PROP_EVENT_RING:
+        g_value_set_object(val, state->event_ring);
+        break;
     default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(self, id, spec);
         break;
     }
 }
 
-void alsa_firewire_state_init(struct alsa_firewire_state *state)
+void alsa_firewire_state_init(struct alsa_firewire_state *state, HitakiAlsaFirewire *self,
+                              void (*handle_event)(HitakiAlsaFirewire *self,
+                                                   const union snd_firewire_event *event,
+                                                   size_t length))
 {
     state->fd = -1;
+    state->backend = &alsa_firewire_kernel_backend;
+    state->backend_data = NULL;
     state->is_locked = FALSE;
     state->is_disconnected = FALSE;
+    state->dispatch_budget = DEFAULT_DISPATCH_BUDGET;
+    state->is_nonblocking = FALSE;
+    state->event_ring = NULL;
+    memset(&state->stats, 0, sizeof(state->stats));
+    state->dispatch_time = 0;
+
+    // The state is retrieved by the unit instance when dispatching events without the source
+    // specific to the unit.
+    state->unit = self;
+    state->handle_event = handle_event;
+    g_object_set_qdata(G_OBJECT(self), alsa_firewire_state_quark(), state);
+}
+
+struct alsa_firewire_state *alsa_firewire_state_from_unit(HitakiAlsaFirewire *self)
+{
+    return g_object_get_qdata(G_OBJECT(self), alsa_firewire_state_quark());
 }
 
 void alsa_firewire_state_release(struct alsa_firewire_state *state)
 {
     if (state->fd >= 0)
-        close(state->fd);
+        state->backend->close(state);
     state->fd = -1;
 }
 
@@ -102,9 +185,14 @@ gboolean alsa_firewire_state_open(struct alsa_firewire_state *state, const gchar
         return FALSE;
     }
 
+    if (g_str_has_prefix(path, LOOPBACK_PATH_PREFIX))
+        state->backend = &alsa_firewire_loopback_backend;
+    else
+        state->backend = &alsa_firewire_kernel_backend;
+
     // Open ALSA HwDep character device.
     open_flag |= O_RDONLY;
-    state->fd = open(path, open_flag);
+    state->fd = state->backend->open(state, path, open_flag);
     if (state->fd < 0) {
         if (errno == ENODEV) {
             generate_alsa_firewire_error(error, HITAKI_ALSA_FIREWIRE_ERROR_IS_DISCONNECTED);
@@ -121,8 +209,10 @@ gboolean alsa_firewire_state_open(struct alsa_firewire_state *state, const gchar
         return FALSE;
     }
 
+    state->is_nonblocking = !!(fcntl(state->fd, F_GETFL) & O_NONBLOCK);
+
     // Get FireWire sound device information.
-    if (ioctl(state->fd, SNDRV_FIREWIRE_IOCTL_GET_INFO, &state->info) < 0) {
+    if (alsa_firewire_state_ioctl(state, SNDRV_FIREWIRE_IOCTL_GET_INFO, &state->info) < 0) {
         if (errno == ENODEV)
             generate_alsa_firewire_error(error, HITAKI_ALSA_FIREWIRE_ERROR_IS_DISCONNECTED);
         else
@@ -142,7 +232,7 @@ gboolean alsa_firewire_state_lock(struct alsa_firewire_state *state, GError **er
         return FALSE;
     }
 
-    if (ioctl(state->fd, SNDRV_FIREWIRE_IOCTL_LOCK, NULL) < 0) {
+    if (alsa_firewire_state_ioctl(state, SNDRV_FIREWIRE_IOCTL_LOCK, NULL) < 0) {
         if (errno == ENODEV)
             generate_alsa_firewire_error(error, HITAKI_ALSA_FIREWIRE_ERROR_IS_DISCONNECTED);
         else if (errno == EBUSY)
@@ -165,7 +255,7 @@ gboolean alsa_firewire_state_unlock(struct alsa_firewire_state *state, GError **
         return FALSE;
     }
 
-    if (ioctl(state->fd, SNDRV_FIREWIRE_IOCTL_UNLOCK, NULL) < 0) {
+    if (alsa_firewire_state_ioctl(state, SNDRV_FIREWIRE_IOCTL_UNLOCK, NULL) < 0) {
         if (errno == ENODEV)
             generate_alsa_firewire_error(error, HITAKI_ALSA_FIREWIRE_ERROR_IS_DISCONNECTED);
         else if (errno == EBADFD)
@@ -207,40 +297,142 @@ static void handle_lock_status(HitakiAlsaFirewire *self,
         g_object_notify(G_OBJECT(self), IS_LOCKED_PROP_NAME);
 }
 
-static gboolean dispatch_src(GSource *source, GSourceFunc cb, gpointer user_data)
+// Check whether the next event is available without blocking.
+static gboolean is_event_available(const struct alsa_firewire_state *state)
 {
-    AlsaFirewireSource *src = (AlsaFirewireSource *)source;
-    HitakiAlsaFirewire *unit = src->unit;
-    GIOCondition condition;
-    union snd_firewire_event *event;
-    ssize_t len;
+    struct pollfd pfd = {
+        .fd = state->fd,
+        .events = POLLIN,
+    };
 
-    condition = g_source_query_unix_fd(source, src->tag);
-    if (condition & G_IO_ERR) {
-        GValue value = G_VALUE_INIT;
+    // The read(2) returns EAGAIN when nothing available.
+    if (state->is_nonblocking)
+        return TRUE;
 
-        g_value_init(&value, G_TYPE_BOOLEAN);
-        g_value_set_boolean(&value, TRUE);
-        g_object_set_property(G_OBJECT(unit), IS_DISCONNECTED_PROP_NAME, &value);
-        g_object_notify(G_OBJECT(unit), IS_DISCONNECTED_PROP_NAME);
+    if (poll(&pfd, 1, 0) <= 0)
+        return FALSE;
 
-        return G_SOURCE_REMOVE;
-    }
+    return !!(pfd.revents & POLLIN);
+}
 
-    len = read(src->fd, src->buf, src->len);
-    if (len <= 0) {
-        if (errno != EAGAIN)
-            return G_SOURCE_REMOVE;
-        else
-            return G_SOURCE_CONTINUE;
-    }
+void alsa_firewire_state_handle_disconnection(struct alsa_firewire_state *state)
+{
+    HitakiAlsaFirewire *unit = state->unit;
+    GValue value = G_VALUE_INIT;
 
-    event = (union snd_firewire_event *)src->buf;
+    g_value_init(&value, G_TYPE_BOOLEAN);
+    g_value_set_boolean(&value, TRUE);
+    g_object_set_property(G_OBJECT(unit), IS_DISCONNECTED_PROP_NAME, &value);
+    g_object_notify(G_OBJECT(unit), IS_DISCONNECTED_PROP_NAME);
+}
+
+static void record_latency(struct alsa_firewire_state *state, gint64 dispatch_time)
+{
+    gint64 latency = g_get_monotonic_time() - dispatch_time;
+    guint bucket = 0;
+
+    if (latency > 0)
+        bucket = MIN(g_bit_storage(latency), STATS_LATENCY_BUCKET_COUNT - 1);
+
+    alsa_firewire_stats_add(&state->stats.latency_histogram[bucket], 1);
+}
+
+void alsa_firewire_state_handle_event(struct alsa_firewire_state *state,
+                                      const union snd_firewire_event *event, size_t length,
+                                      gint64 dispatch_time)
+{
+    record_latency(state, dispatch_time);
+
+    TRACE_PROBE3(handle_event_entry, state->info.card, event->common.type, length);
 
     if (event->common.type == SNDRV_FIREWIRE_EVENT_LOCK_STATUS)
-        handle_lock_status(unit, &event->lock_status);
+        handle_lock_status(state->unit, &event->lock_status);
     else
-        src->handle_event(unit, event, len);
+        state->handle_event(state->unit, event, length);
+
+    TRACE_PROBE2(handle_event_exit, state->info.card, event->common.type);
+}
+
+// Read events from the file descriptor into the given buffer, then deliver them. It returns FALSE
+// when the file descriptor is not available anymore.
+gboolean alsa_firewire_state_read_events(struct alsa_firewire_state *state, void *buf, size_t len,
+                                         void (*deliver)(struct alsa_firewire_state *state,
+                                                         const union snd_firewire_event *event,
+                                                         size_t length, gpointer user_data),
+                                         gpointer user_data)
+{
+    ssize_t length;
+    guint budget;
+    guint delivered = 0;
+
+    // Drain queued events up to the budget so that burst of events is handled in one dispatch.
+    budget = MAX(state->dispatch_budget, 1);
+    TRACE_PROBE2(read_entry, state->info.card, budget);
+    do {
+        length = alsa_firewire_state_read(state, buf, len);
+        if (length == 0) {
+            // The end of file. The errno is meaningless since it is left by the former call.
+            TRACE_PROBE3(read_exit, state->info.card, delivered, 0);
+            return FALSE;
+        } else if (length < 0) {
+            if (errno != EAGAIN) {
+                TRACE_PROBE3(read_exit, state->info.card, delivered, errno);
+                return FALSE;
+            }
+
+            alsa_firewire_stats_add(&state->stats.again_count, 1);
+            break;
+        }
+
+        alsa_firewire_stats_add(&state->stats.read_count, 1);
+        alsa_firewire_stats_add(&state->stats.byte_count, length);
+
+        // The event without the type is not delivered.
+        if (length < sizeof(struct snd_firewire_event_common)) {
+            alsa_firewire_stats_add(&state->stats.short_read_count, 1);
+            continue;
+        }
+
+        alsa_firewire_stats_add(&state->stats.event_count, 1);
+        deliver(state, (const union snd_firewire_event *)buf, length, user_data);
+        ++delivered;
+    } while (--budget > 0 && is_event_available(state));
+
+    TRACE_PROBE3(read_exit, state->info.card, delivered, 0);
+
+    return TRUE;
+}
+
+static void deliver_event(struct alsa_firewire_state *state, const union snd_firewire_event *event,
+                          size_t length, gpointer user_data)
+{
+    alsa_firewire_state_handle_event(state, event, length, state->dispatch_time);
+}
+
+// Read events from the file descriptor into the given buffer, then handle them. It returns FALSE
+// when the file descriptor is not available anymore.
+gboolean alsa_firewire_state_dispatch(struct alsa_firewire_state *state, GIOCondition condition,
+                                      gint64 dispatch_time, void *buf, size_t len)
+{
+    if (condition & G_IO_ERR) {
+        alsa_firewire_state_handle_disconnection(state);
+        return FALSE;
+    }
+
+    state->dispatch_time = dispatch_time;
+
+    return alsa_firewire_state_read_events(state, buf, len, deliver_event, NULL);
+}
+
+static gboolean dispatch_src(GSource *source, GSourceFunc cb, gpointer user_data)
+{
+    AlsaFirewireSource *src = (AlsaFirewireSource *)source;
+    GIOCondition condition;
+
+    condition = g_source_query_unix_fd(source, src->tag);
+    if (!alsa_firewire_state_dispatch(src->state, condition, g_source_get_time(source), src->buf,
+                                      src->len))
+        return G_SOURCE_REMOVE;
 
     return G_SOURCE_CONTINUE;
 }
@@ -252,12 +444,69 @@ static void finalize_src(GSource *source)
     g_free(src->buf);
 }
 
-gboolean alsa_firewire_state_create_source(struct alsa_firewire_state *state,
-                                           HitakiAlsaFirewire *self,
-                                           void (*handle_event)(HitakiAlsaFirewire *self,
-                                                            const union snd_firewire_event *event,
-                                                            size_t length),
-                                           GSource **source, GError **error)
+// Each counter is read atomically, while the set of counters is not consistent as a whole.
+void alsa_firewire_state_snapshot_stats(const struct alsa_firewire_state *state,
+                                        struct alsa_firewire_stats *stats)
+{
+    const guint64 *src = (const guint64 *)&state->stats;
+    guint64 *dst = (guint64 *)stats;
+    int i;
+
+    for (i = 0; i < sizeof(*stats) / sizeof(*dst); ++i)
+        dst[i] = __atomic_load_n(&src[i], __ATOMIC_RELAXED);
+}
+
+void alsa_firewire_state_reset_stats(struct alsa_firewire_state *state)
+{
+    guint64 *counters = (guint64 *)&state->stats;
+    int i;
+
+    for (i = 0; i < sizeof(state->stats) / sizeof(*counters); ++i)
+        __atomic_store_n(&counters[i], 0, __ATOMIC_RELAXED);
+}
+
+// Push the decoded event to the queue when assigned.
+void alsa_firewire_state_push_event(const struct alsa_firewire_state *state,
+                                    HitakiUnitEventType type, const guint32 *values,
+                                    unsigned int count)
+{
+    struct unit_event event = {
+        .type = type,
+        .card_id = state->info.card,
+    };
+
+    if (state->event_ring == NULL)
+        return;
+
+    memcpy(event.values, values, sizeof(*values) * MIN(count, UNIT_EVENT_VALUE_COUNT));
+    event_ring_push(state->event_ring, &event);
+}
+
+// Check locked or not.
+void alsa_firewire_state_check_lock(struct alsa_firewire_state *state)
+{
+    HitakiAlsaFirewire *self = state->unit;
+    GError *error = NULL;
+    gboolean is_locked;
+
+    is_locked = state->is_locked;
+    if (!hitaki_alsa_firewire_lock(self, &error)) {
+        if (error != NULL) {
+            if (error->code == HITAKI_ALSA_FIREWIRE_ERROR_IS_LOCKED)
+                state->is_locked = TRUE;
+            g_clear_error(&error);
+        }
+    } else {
+        hitaki_alsa_firewire_unlock(self, &error);
+        g_clear_error(&error);
+        state->is_locked = FALSE;
+    }
+    if (is_locked != state->is_locked)
+        g_object_notify(G_OBJECT(self), IS_LOCKED_PROP_NAME);
+}
+
+gboolean alsa_firewire_state_create_source(struct alsa_firewire_state *state, GSource **source,
+                                           GError **error)
 {
     static GSourceFuncs funcs = {
         .check      = check_src,
@@ -265,11 +514,9 @@ gboolean alsa_firewire_state_create_source(struct alsa_firewire_state *state,
         .finalize   = finalize_src,
     };
     AlsaFirewireSource *src;
-    gboolean is_locked;
 
-    g_return_val_if_fail(HITAKI_IS_ALSA_FIREWIRE(self), FALSE);
     g_return_val_if_fail(state != NULL, FALSE);
-    g_return_val_if_fail(handle_event != NULL, FALSE);
+    g_return_val_if_fail(state->handle_event != NULL, FALSE);
     g_return_val_if_fail(source != NULL, FALSE);
     g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
 
@@ -287,26 +534,10 @@ gboolean alsa_firewire_state_create_source(struct alsa_firewire_state *state,
     src->len = sysconf(_SC_PAGESIZE);
     src->buf = g_malloc(src->len);
 
-    src->fd = state->fd;
-    src->unit = self;
+    src->state = state;
     src->tag = g_source_add_unix_fd(*source, state->fd, G_IO_IN);
-    src->handle_event = handle_event;
 
-    // Check locked or not.
-    is_locked = state->is_locked;
-    if (!hitaki_alsa_firewire_lock(self, error)) {
-        if (*error != NULL) {
-            if ((*error)->code == HITAKI_ALSA_FIREWIRE_ERROR_IS_LOCKED)
-                state->is_locked = TRUE;
-            g_clear_error(error);
-        }
-    } else {
-        hitaki_alsa_firewire_unlock(self, error);
-        g_clear_error(error);
-        state->is_locked = FALSE;
-    }
-    if (is_locked != state->is_locked)
-        g_object_notify(G_OBJECT(self), IS_LOCKED_PROP_NAME);
+    alsa_firewire_state_check_lock(state);
 
     return TRUE;
 }
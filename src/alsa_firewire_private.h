@@ -29,6 +29,8 @@ enum alsa_firewire_prop_type {
     ALSA_FIREWIRE_PROP_IS_LOCKED,
     ALSA_FIREWIRE_PROP_GUID,
     ALSA_FIREWIRE_PROP_IS_DISCONNECTED,
+    ALSA_FIREWIRE_PROP_DISPATCH_BUDGET,
+    ALSA_FIREWIRE_PROP_EVENT_RING,
     ALSA_FIREWIRE_PROP_COUNT,
 };
 
@@ -38,12 +40,69 @@ enum alsa_firewire_prop_type {
 #define IS_LOCKED_PROP_NAME         "is-locked"
 #define GUID_PROP_NAME              "guid"
 #define IS_DISCONNECTED_PROP_NAME   "is-disconnected"
+#define DISPATCH_BUDGET_PROP_NAME   "dispatch-budget"
+#define EVENT_RING_PROP_NAME        "event-ring"
+
+#define DEFAULT_DISPATCH_BUDGET     1
+
+// The path prefix to select the loopback backend instead of the character device of ALSA HwDep;
+// e.g. 'loopback:tascam'.
+#define LOOPBACK_PATH_PREFIX        "loopback:"
+
+struct alsa_firewire_state;
+
+// The operations against the character device. Each of them follows the semantics of the
+// corresponding system call; i.e. it returns negative value and sets errno at failure.
+struct alsa_firewire_backend {
+    int (*open)(struct alsa_firewire_state *state, const char *path, int open_flag);
+    void (*close)(struct alsa_firewire_state *state);
+    int (*ioctl)(struct alsa_firewire_state *state, unsigned long request, void *arg);
+    ssize_t (*read)(struct alsa_firewire_state *state, void *buf, size_t len);
+    ssize_t (*write)(struct alsa_firewire_state *state, const void *buf, size_t len);
+};
+
+extern const struct alsa_firewire_backend alsa_firewire_kernel_backend;
+extern const struct alsa_firewire_backend alsa_firewire_loopback_backend;
+
+// The bucket of histogram for latency in microsecond. The first bucket is for zero, and the n-th
+// bucket is for the range between 2^(n-1) and 2^n - 1. The last bucket has no upper bound.
+#define STATS_LATENCY_BUCKET_COUNT  20
+
+// The counters are updated with relaxed atomic operation by the thread to dispatch events, and
+// read by the other threads.
+struct alsa_firewire_stats {
+    guint64 read_count;
+    guint64 byte_count;
+    guint64 event_count;
+    guint64 short_read_count;
+    guint64 again_count;
+    guint64 signal_count;
+    guint64 latency_histogram[STATS_LATENCY_BUCKET_COUNT];
+};
+
+static inline void alsa_firewire_stats_add(guint64 *counter, guint64 value)
+{
+    __atomic_fetch_add(counter, value, __ATOMIC_RELAXED);
+}
 
 struct alsa_firewire_state {
     int fd;
+    const struct alsa_firewire_backend *backend;
+    gpointer backend_data;
     struct snd_firewire_get_info info;
     gboolean is_locked;
     gboolean is_disconnected;
+    guint dispatch_budget;
+    gboolean is_nonblocking;
+    HitakiEventRing *event_ring;
+
+    struct alsa_firewire_stats stats;
+    // The time in microsecond at which the dispatcher woke up for the events.
+    gint64 dispatch_time;
+
+    HitakiAlsaFirewire *unit;
+    void (*handle_event)(HitakiAlsaFirewire *self, const union snd_firewire_event *event,
+                         size_t length);
 };
 
 void alsa_firewire_class_override_properties(GObjectClass *gobject_class);
@@ -52,7 +111,10 @@ void alsa_firewire_state_set_property(struct alsa_firewire_state *state, GObject
 void alsa_firewire_state_get_property(const struct alsa_firewire_state *state, GObject *self,
                                       guint id, GValue *val, GParamSpec *spec);
 
-void alsa_firewire_state_init(struct alsa_firewire_state *state);
+void alsa_firewire_state_init(struct alsa_firewire_state *state, HitakiAlsaFirewire *self,
+                              void (*handle_event)(HitakiAlsaFirewire *self,
+                                                   const union snd_firewire_event *event,
+                                                   size_t length));
 void alsa_firewire_state_release(struct alsa_firewire_state *state);
 
 gboolean alsa_firewire_state_open(struct alsa_firewire_state *state, const gchar *path, gint open_flag,
@@ -62,11 +124,68 @@ gboolean alsa_firewire_state_lock(struct alsa_firewire_state *state, GError **er
 
 gboolean alsa_firewire_state_unlock(struct alsa_firewire_state *state, GError **error);
 
-gboolean alsa_firewire_state_create_source(struct alsa_firewire_state *state,
-                                           HitakiAlsaFirewire *self,
-                                           void (*handle_event)(HitakiAlsaFirewire *self,
-                                                            const union snd_firewire_event *event,
-                                                            size_t length),
-                                           GSource **source, GError **error);
+struct alsa_firewire_state *alsa_firewire_state_from_unit(HitakiAlsaFirewire *self);
+
+void alsa_firewire_state_check_lock(struct alsa_firewire_state *state);
+
+void alsa_firewire_state_handle_disconnection(struct alsa_firewire_state *state);
+
+void alsa_firewire_state_handle_event(struct alsa_firewire_state *state,
+                                      const union snd_firewire_event *event, size_t length,
+                                      gint64 dispatch_time);
+
+gboolean alsa_firewire_state_read_events(struct alsa_firewire_state *state, void *buf, size_t len,
+                                         void (*deliver)(struct alsa_firewire_state *state,
+                                                         const union snd_firewire_event *event,
+                                                         size_t length, gpointer user_data),
+                                         gpointer user_data);
+
+gboolean alsa_firewire_state_dispatch(struct alsa_firewire_state *state, GIOCondition condition,
+                                      gint64 dispatch_time, void *buf, size_t len);
+
+static inline void alsa_firewire_state_count_signals(struct alsa_firewire_state *state,
+                                                     guint count)
+{
+    alsa_firewire_stats_add(&state->stats.signal_count, count);
+}
+
+void alsa_firewire_state_snapshot_stats(const struct alsa_firewire_state *state,
+                                        struct alsa_firewire_stats *stats);
+
+void alsa_firewire_state_reset_stats(struct alsa_firewire_state *state);
+
+void alsa_firewire_state_push_event(const struct alsa_firewire_state *state,
+                                    HitakiUnitEventType type, const guint32 *values,
+                                    unsigned int count);
+
+static inline int alsa_firewire_state_ioctl(struct alsa_firewire_state *state,
+                                            unsigned long request, void *arg)
+{
+    return state->backend->ioctl(state, request, arg);
+}
+
+static inline ssize_t alsa_firewire_state_read(struct alsa_firewire_state *state, void *buf,
+                                               size_t len)
+{
+    return state->backend->read(state, buf, len);
+}
+
+static inline ssize_t alsa_firewire_state_write(struct alsa_firewire_state *state,
+                                                const void *buf, size_t len)
+{
+    return state->backend->write(state, buf, len);
+}
+
+gboolean alsa_firewire_loopback_inject_event(struct alsa_firewire_state *state,
+                                             const union snd_firewire_event *event, size_t length,
+                                             GError **error);
+
+gboolean alsa_firewire_loopback_update(struct alsa_firewire_state *state, unsigned long request,
+                                       const void *data, size_t size, GError **error);
+
+gboolean alsa_firewire_loopback_hang_up(struct alsa_firewire_state *state, GError **error);
+
+gboolean alsa_firewire_state_create_source(struct alsa_firewire_state *state, GSource **source,
+                                           GError **error);
 
 #endif
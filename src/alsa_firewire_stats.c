@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#include "alsa_firewire_private.h"
+
+#include <string.h>
+
+/**
+ * HitakiAlsaFirewireStats:
+ * A boxed object for the snapshot of runtime statistics of unit.
+ *
+ * A [struct@AlsaFirewireStats] is a boxed object with fixed size for the snapshot of counters
+ * maintained by the unit to dispatch events from ALSA HwDep character device. It is retrieved by
+ * [method@AlsaFirewire.get_stats].
+ */
+G_STATIC_ASSERT(sizeof(struct alsa_firewire_stats) <= sizeof(HitakiAlsaFirewireStats));
+
+static HitakiAlsaFirewireStats *alsa_firewire_stats_copy(const HitakiAlsaFirewireStats *self)
+{
+#ifdef g_memdup2
+    return g_memdup2(self, sizeof(*self));
+#else
+    // GLib v2.68 deprecated g_memdup() with concern about overflow by narrow conversion from size_t to
+    // unsigned int however it's safe in the local case.
+    gpointer ptr = g_malloc(sizeof(*self));
+    memcpy(ptr, self, sizeof(*self));
+    return ptr;
+#endif
+}
+
+G_DEFINE_BOXED_TYPE(HitakiAlsaFirewireStats, hitaki_alsa_firewire_stats, alsa_firewire_stats_copy,
+                    g_free)
+
+/**
+ * hitaki_alsa_firewire_stats_new:
+ *
+ * Instantiate [struct@AlsaFirewireStats] object and return the instance.
+ *
+ * Returns: an instance of [struct@AlsaFirewireStats].
+ */
+HitakiAlsaFirewireStats *hitaki_alsa_firewire_stats_new(void)
+{
+    return g_malloc0(sizeof(HitakiAlsaFirewireStats));
+}
+
+/**
+ * hitaki_alsa_firewire_stats_get_read_count:
+ * @self: A [struct@AlsaFirewireStats].
+ * @count: (out): The number of successful calls of `read(2)` system call.
+ *
+ * Get the number of successful calls of `read(2)` system call to the character device.
+ */
+void hitaki_alsa_firewire_stats_get_read_count(const HitakiAlsaFirewireStats *self,
+                                               guint64 *count)
+{
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(count != NULL);
+
+    *count = ((const struct alsa_firewire_stats *)self)->read_count;
+}
+
+/**
+ * hitaki_alsa_firewire_stats_get_byte_count:
+ * @self: A [struct@AlsaFirewireStats].
+ * @count: (out): The total number of bytes read from the character device.
+ *
+ * Get the total number of bytes read from the character device.
+ */
+void hitaki_alsa_firewire_stats_get_byte_count(const HitakiAlsaFirewireStats *self,
+                                               guint64 *count)
+{
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(count != NULL);
+
+    *count = ((const struct alsa_firewire_stats *)self)->byte_count;
+}
+
+/**
+ * hitaki_alsa_firewire_stats_get_event_count:
+ * @self: A [struct@AlsaFirewireStats].
+ * @count: (out): The number of events delivered to the unit.
+ *
+ * Get the number of events read from the character device and delivered to the unit.
+ */
+void hitaki_alsa_firewire_stats_get_event_count(const HitakiAlsaFirewireStats *self,
+                                                guint64 *count)
+{
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(count != NULL);
+
+    *count = ((const struct alsa_firewire_stats *)self)->event_count;
+}
+
+/**
+ * hitaki_alsa_firewire_stats_get_short_read_count:
+ * @self: A [struct@AlsaFirewireStats].
+ * @count: (out): The number of reads too short to include the type of event.
+ *
+ * Get the number of reads too short to include the type of event. Such events are discarded.
+ */
+void hitaki_alsa_firewire_stats_get_short_read_count(const HitakiAlsaFirewireStats *self,
+                                                     guint64 *count)
+{
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(count != NULL);
+
+    *count = ((const struct alsa_firewire_stats *)self)->short_read_count;
+}
+
+/**
+ * hitaki_alsa_firewire_stats_get_again_count:
+ * @self: A [struct@AlsaFirewireStats].
+ * @count: (out): The number of reads failed with `EAGAIN`.
+ *
+ * Get the number of reads which failed with `EAGAIN` since nothing was available.
+ */
+void hitaki_alsa_firewire_stats_get_again_count(const HitakiAlsaFirewireStats *self,
+                                                guint64 *count)
+{
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(count != NULL);
+
+    *count = ((const struct alsa_firewire_stats *)self)->again_count;
+}
+
+/**
+ * hitaki_alsa_firewire_stats_get_signal_count:
+ * @self: A [struct@AlsaFirewireStats].
+ * @count: (out): The number of signals emitted for the events.
+ *
+ * Get the number of signals emitted by the unit for the events. The
+ * [signal@EfwProtocol::responded] signal is not counted.
+ */
+void hitaki_alsa_firewire_stats_get_signal_count(const HitakiAlsaFirewireStats *self,
+                                                 guint64 *count)
+{
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(count != NULL);
+
+    *count = ((const struct alsa_firewire_stats *)self)->signal_count;
+}
+
+/**
+ * hitaki_alsa_firewire_stats_get_latency_histogram:
+ * @self: A [struct@AlsaFirewireStats].
+ * @histogram: (array fixed-size=20)(out)(transfer none): The array with elements for the buckets
+ *             of histogram.
+ *
+ * Get the histogram of latency between the wake-up of dispatcher and the delivery of each event
+ * to the handler in the unit. The first bucket counts the latency less than one microsecond, and
+ * the n-th bucket counts the latency between 2^(n-1) and 2^n - 1 microseconds. The last bucket
+ * counts the rest.
+ */
+void hitaki_alsa_firewire_stats_get_latency_histogram(const HitakiAlsaFirewireStats *self,
+                                                      const guint64 *histogram[20])
+{
+    G_STATIC_ASSERT(STATS_LATENCY_BUCKET_COUNT == 20);
+
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(histogram != NULL);
+
+    *histogram = ((const struct alsa_firewire_stats *)self)->latency_histogram;
+}
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#ifndef __HITAKI_ALSA_FIREWIRE_STATS_H__
+#define __HITAKI_ALSA_FIREWIRE_STATS_H__
+
+#include <hitaki.h>
+
+G_BEGIN_DECLS
+
+#define HITAKI_TYPE_ALSA_FIREWIRE_STATS (hitaki_alsa_firewire_stats_get_type())
+
+typedef struct {
+    /*< private >*/
+    guint64 reserved[32];
+} HitakiAlsaFirewireStats;
+
+GType hitaki_alsa_firewire_stats_get_type() G_GNUC_CONST;
+
+HitakiAlsaFirewireStats *hitaki_alsa_firewire_stats_new(void);
+
+void hitaki_alsa_firewire_stats_get_read_count(const HitakiAlsaFirewireStats *self,
+                                               guint64 *count);
+
+void hitaki_alsa_firewire_stats_get_byte_count(const HitakiAlsaFirewireStats *self,
+                                               guint64 *count);
+
+void hitaki_alsa_firewire_stats_get_event_count(const HitakiAlsaFirewireStats *self,
+                                                guint64 *count);
+
+void hitaki_alsa_firewire_stats_get_short_read_count(const HitakiAlsaFirewireStats *self,
+                                                     guint64 *count);
+
+void hitaki_alsa_firewire_stats_get_again_count(const HitakiAlsaFirewireStats *self,
+                                                guint64 *count);
+
+void hitaki_alsa_firewire_stats_get_signal_count(const HitakiAlsaFirewireStats *self,
+                                                 guint64 *count);
+
+void hitaki_alsa_firewire_stats_get_latency_histogram(const HitakiAlsaFirewireStats *self,
+                                                      const guint64 *histogram[20]);
+
+G_END_DECLS
+
+#endif
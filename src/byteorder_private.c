@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#include "byteorder_private.h"
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAS_X86_KERNELS
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define HAS_NEON_KERNEL
+#endif
+
+// The conversion between big endian and host endian is the same swap of bytes in each quadlet.
+// The kernel for the host is selected at runtime by the features of CPU, then cached.
+
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+
+typedef void (*swap_kernel_t)(guint32 *dst, const guint32 *src, gsize count);
+
+static void swap_scalar(guint32 *dst, const guint32 *src, gsize count)
+{
+    gsize i;
+
+    for (i = 0; i < count; ++i)
+        dst[i] = GUINT32_SWAP_LE_BE(src[i]);
+}
+
+#if defined(HAS_X86_KERNELS)
+__attribute__((target("sse2")))
+static void swap_sse2(guint32 *dst, const guint32 *src, gsize count)
+{
+    gsize i;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+
+        // Swap bytes in each 16 bit word, then swap the words in each quadlet.
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_si128((__m128i *)(dst + i), v);
+    }
+
+    swap_scalar(dst + i, src + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static void swap_avx2(guint32 *dst, const guint32 *src, gsize count)
+{
+    const __m256i mask = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                          3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    gsize i;
+
+    for (i = 0; i + 8 <= count; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(src + i));
+
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_shuffle_epi8(v, mask));
+    }
+
+    swap_scalar(dst + i, src + i, count - i);
+}
+#elif defined(HAS_NEON_KERNEL)
+static void swap_neon(guint32 *dst, const guint32 *src, gsize count)
+{
+    gsize i;
+
+    for (i = 0; i + 4 <= count; i += 4) {
+        uint8x16_t v = vld1q_u8((const uint8_t *)(src + i));
+
+        vst1q_u8((uint8_t *)(dst + i), vrev32q_u8(v));
+    }
+
+    swap_scalar(dst + i, src + i, count - i);
+}
+#endif
+
+static swap_kernel_t select_kernel(void)
+{
+#if defined(HAS_X86_KERNELS)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return swap_avx2;
+    if (__builtin_cpu_supports("sse2"))
+        return swap_sse2;
+#elif defined(HAS_NEON_KERNEL)
+    // Available as long as the compiler is allowed to use it.
+    return swap_neon;
+#endif
+    return swap_scalar;
+}
+
+static void swap_quadlets(guint32 *dst, const guint32 *src, gsize count)
+{
+    static swap_kernel_t kernel = NULL;
+    swap_kernel_t func;
+
+    // Selection by several threads at the same time results in the same kernel.
+    func = g_atomic_pointer_get(&kernel);
+    if (func == NULL) {
+        func = select_kernel();
+        g_atomic_pointer_set(&kernel, func);
+    }
+
+    func(dst, src, count);
+}
+
+// List the kernels available in the host so that test can compare them.
+guint list_swap_kernels(struct swap_kernel kernels[SWAP_KERNEL_COUNT_MAX])
+{
+    guint count = 0;
+
+    kernels[count++] = (struct swap_kernel){ "scalar", swap_scalar };
+#if defined(HAS_X86_KERNELS)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2"))
+        kernels[count++] = (struct swap_kernel){ "sse2", swap_sse2 };
+    if (__builtin_cpu_supports("avx2"))
+        kernels[count++] = (struct swap_kernel){ "avx2", swap_avx2 };
+#elif defined(HAS_NEON_KERNEL)
+    kernels[count++] = (struct swap_kernel){ "neon", swap_neon };
+#endif
+
+    return count;
+}
+
+#else
+
+// No conversion is required in big endian host.
+static void swap_quadlets(guint32 *dst, const guint32 *src, gsize count)
+{
+    if (dst != src)
+        memmove(dst, src, count * sizeof(*dst));
+}
+
+// No kernel is used in big endian host.
+guint list_swap_kernels(struct swap_kernel kernels[SWAP_KERNEL_COUNT_MAX])
+{
+    return 0;
+}
+
+#endif
+
+// Convert the array of quadlets in big endianness to host endianness. The same array is
+// available for both destination and source.
+void quadlets_from_be(guint32 *dst, const guint32 *src, gsize count)
+{
+    swap_quadlets(dst, src, count);
+}
+
+// Convert the array of quadlets in host endianness to big endianness. The same array is
+// available for both destination and source.
+void quadlets_to_be(guint32 *dst, const guint32 *src, gsize count)
+{
+    swap_quadlets(dst, src, count);
+}
@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#ifndef __HITAKI_BYTEORDER_PRIVATE_H__
+#define __HITAKI_BYTEORDER_PRIVATE_H__
+
+#include "hitaki.h"
+
+void quadlets_from_be(guint32 *dst, const guint32 *src, gsize count);
+void quadlets_to_be(guint32 *dst, const guint32 *src, gsize count);
+
+#define SWAP_KERNEL_COUNT_MAX   3
+
+struct swap_kernel {
+    const char *name;
+    void (*func)(guint32 *dst, const guint32 *src, gsize count);
+};
+
+guint list_swap_kernels(struct swap_kernel kernels[SWAP_KERNEL_COUNT_MAX]);
+
+#endif
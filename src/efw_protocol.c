@@ -1,5 +1,7 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 #include "efw_protocol_private.h"
+#include "byteorder_private.h"
+#include "trace_private.h"
 
 #include <sound/firewire.h>
 
@@ -32,9 +34,20 @@ G_DEFINE_QUARK(hitaki-efw-protocol-error-quark, hitaki_efw_protocol_error)
 #define MINIMUM_SUPPORTED_VERSION   1
 #define MAXIMUM_FRAME_BYTES         0x200U
 #define MAXIMUM_FRAME_QUADLETS      (MAXIMUM_FRAME_BYTES / sizeof(__be32))
+#define MAXIMUM_PARAM_QUADLETS      (MAXIMUM_FRAME_QUADLETS - HEADER_QUADLET_COUNT)
+
+// The sequence number for request is even, thus the number of transactions pending at the same
+// time is limited.
+#define MAXIMUM_BATCH_FRAMES        (SND_EFW_TRANSACTION_USER_SEQNUM_MAX / 2 + 1)
 
 #define RESPONDED_EVENT_NAME        "responded"
 
+enum efw_protocol_sig_type {
+    EFW_PROTOCOL_SIG_RESPONDED = 0,
+    EFW_PROTOCOL_SIG_COUNT,
+};
+static guint efw_protocol_sigs[EFW_PROTOCOL_SIG_COUNT] = { 0 };
+
 /**
  * hitaki_efw_protocol_error_to_label:
  * @code: A Hitaki.EfwProtocolError.
@@ -110,15 +123,57 @@ static void hitaki_efw_protocol_default_init(HitakiEfwProtocolInterface *iface)
      * transaction and the process successfully reads the content of response from ALSA Efw
      * driver.
      */
-    g_signal_new(RESPONDED_EVENT_NAME,
-                 G_TYPE_FROM_INTERFACE(iface),
-                 G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
-                 G_STRUCT_OFFSET(HitakiEfwProtocolInterface, responded),
-                 NULL, NULL,
-                 hitaki_sigs_marshal_VOID__UINT_UINT_UINT_UINT_ENUM_POINTER_UINT,
-                 G_TYPE_NONE,
-                 7, G_TYPE_UINT, G_TYPE_UINT, G_TYPE_UINT, G_TYPE_UINT,
-                 HITAKI_TYPE_EFW_PROTOCOL_ERROR, G_TYPE_POINTER, G_TYPE_UINT);
+    efw_protocol_sigs[EFW_PROTOCOL_SIG_RESPONDED] =
+        g_signal_new(RESPONDED_EVENT_NAME,
+                     G_TYPE_FROM_INTERFACE(iface),
+                     G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
+                     G_STRUCT_OFFSET(HitakiEfwProtocolInterface, responded),
+                     NULL, NULL,
+                     hitaki_sigs_marshal_VOID__UINT_UINT_UINT_UINT_ENUM_POINTER_UINT,
+                     G_TYPE_NONE,
+                     7, G_TYPE_UINT, G_TYPE_UINT, G_TYPE_UINT, G_TYPE_UINT,
+                     HITAKI_TYPE_EFW_PROTOCOL_ERROR, G_TYPE_POINTER, G_TYPE_UINT);
+    g_signal_set_va_marshaller(efw_protocol_sigs[EFW_PROTOCOL_SIG_RESPONDED],
+                               G_TYPE_FROM_INTERFACE(iface),
+                               hitaki_sigs_marshal_VOID__UINT_UINT_UINT_UINT_ENUM_POINTER_UINTv);
+}
+
+static gsize compose_frame(guint8 *buf, guint32 seqnum, guint category, guint command,
+                           const guint32 *args, gsize arg_count)
+{
+    struct snd_efw_transaction *frame;
+    gsize length;
+
+    length = HEADER_SIZE;
+    if (arg_count > 0 && args != NULL)
+        length += arg_count * sizeof(*args);
+
+    frame = (struct snd_efw_transaction *)buf;
+    frame->length = GUINT32_TO_BE(length / 4);
+    frame->version = GUINT32_TO_BE(MINIMUM_SUPPORTED_VERSION);
+    frame->seqnum = GUINT32_TO_BE(seqnum);
+    frame->category = GUINT32_TO_BE(category);
+    frame->command = GUINT32_TO_BE(command);
+    frame->status = GUINT32_TO_BE((guint32)HITAKI_EFW_PROTOCOL_ERROR_INVALID);
+
+    if (args != NULL)
+        quadlets_to_be(frame->params, args, arg_count);
+
+    return length;
+}
+
+static gboolean transmit_frame(HitakiEfwProtocol *self, guint32 seqnum, guint category,
+                               guint command, const guint32 *args, gsize arg_count,
+                               GError **error)
+{
+    guint8 buf[MAXIMUM_FRAME_BYTES];
+    gsize length;
+
+    length = compose_frame(buf, seqnum, category, command, args, arg_count);
+
+    TRACE_PROBE4(efw_transmit_request, self, seqnum, category, command);
+
+    return HITAKI_EFW_PROTOCOL_GET_IFACE(self)->transmit_request(self, buf, length, error);
 }
 
 /**
@@ -143,53 +198,426 @@ gboolean hitaki_efw_protocol_transmit_request(HitakiEfwProtocol *self, guint cat
                                               guint command, const guint32 *args, gsize arg_count,
                                               guint32 *resp_seqnum, GError **error)
 {
-    guint8 buf[MAXIMUM_FRAME_BYTES];
-    struct snd_efw_transaction *frame;
-    HitakiEfwProtocolInterface *iface;
-    gsize length;
     guint32 seqnum;
-    int i;
 
     g_return_val_if_fail(HITAKI_IS_EFW_PROTOCOL(self), FALSE);
     g_return_val_if_fail(resp_seqnum != NULL, FALSE);
     g_return_val_if_fail(arg_count == 0 || args != NULL, FALSE);
     g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
 
-    iface = HITAKI_EFW_PROTOCOL_GET_IFACE(self);
-    iface->get_seqnum(self, &seqnum);
+    HITAKI_EFW_PROTOCOL_GET_IFACE(self)->get_seqnum(self, &seqnum);
 
-    length = HEADER_SIZE;
-    if (arg_count > 0 && args != NULL)
-        length += arg_count * sizeof(*args);
+    // This comes from hardware specification.
+    *resp_seqnum = seqnum + 1;
 
-    frame = (struct snd_efw_transaction *)buf;
-    frame->length = GUINT32_TO_BE(length / 4);
-    frame->version = GUINT32_TO_BE(MINIMUM_SUPPORTED_VERSION);
-    frame->seqnum = GUINT32_TO_BE(seqnum);
-    frame->category = GUINT32_TO_BE(category);
-    frame->command = GUINT32_TO_BE(command);
-    frame->status = GUINT32_TO_BE((guint32)HITAKI_EFW_PROTOCOL_ERROR_INVALID);
+    return transmit_frame(self, seqnum, category, command, args, arg_count, error);
+}
+
+// The bucket of histogram for round trip time in microsecond. The first bucket is for zero, and
+// the n-th bucket is for the range between 2^(n-1) and 2^n - 1. The last bucket has no upper
+// bound.
+#define LATENCY_BUCKET_COUNT        20
+
+// The record of transactions for the pair of category and command.
+struct efw_latency {
+    guint32 category;
+    guint32 command;
+    guint64 histogram[LATENCY_BUCKET_COUNT];
+    guint64 timeout_count;
+    guint64 error_count;
+};
+
+// The table of transactions waiting for response, indexed by the sequence number of response.
+// The table of records for round trip time is protected by the same lock.
+struct efw_transactions {
+    GMutex lock;
+    GHashTable *pendings;
+    GHashTable *latencies;
+};
+
+// The waiter for response in synchronous call.
+struct efw_waiter {
+    GMutex mutex;
+    GCond cond;
+    guint remaining;
+};
+
+struct efw_pending {
+    struct efw_transactions *transactions;
+    guint32 seqnum;
+    guint32 category;
+    guint32 command;
+    gint64 start_time;
 
-    if (args != NULL) {
-        for (i = 0 ; i < arg_count; ++i)
-            frame->params[i] = GUINT32_TO_BE(args[i]);
+    // Hooks to deliver the response to the caller directly.
+    guint32 *(*prepare_buffer)(struct efw_pending *pending, HitakiEfwProtocolError status,
+                               unsigned int param_count);
+    void (*complete)(struct efw_pending *pending, HitakiEfwProtocolError status,
+                     unsigned int param_count);
+
+    // For asynchronous call.
+    GTask *task;
+    GSource *timeout_source;
+    GSource *cancel_source;
+    struct efw_result *result;
+
+    // For synchronous call.
+    struct efw_waiter *waiter;
+    gboolean is_done;
+    HitakiEfwProtocolError status;
+    guint32 *params;
+    gsize capacity;
+    gsize param_count;
+};
+
+struct efw_result {
+    HitakiEfwProtocolError status;
+    gsize param_count;
+    guint32 params[];
+};
+
+static GQuark efw_transactions_quark(void)
+{
+    return g_quark_from_static_string("hitaki-efw-protocol-transactions");
+}
+
+static guint efw_latency_hash(gconstpointer key)
+{
+    const struct efw_latency *latency = key;
+
+    return (latency->category << 16) ^ latency->command;
+}
+
+static gboolean efw_latency_equal(gconstpointer a, gconstpointer b)
+{
+    const struct efw_latency *lhs = a;
+    const struct efw_latency *rhs = b;
+
+    return lhs->category == rhs->category && lhs->command == rhs->command;
+}
+
+static void efw_transactions_free(gpointer data)
+{
+    struct efw_transactions *transactions = (struct efw_transactions *)data;
+
+    g_hash_table_unref(transactions->latencies);
+    g_hash_table_unref(transactions->pendings);
+    g_mutex_clear(&transactions->lock);
+    g_free(transactions);
+}
+
+static struct efw_transactions *peek_transactions(HitakiEfwProtocol *self)
+{
+    return g_object_get_qdata(G_OBJECT(self), efw_transactions_quark());
+}
+
+static struct efw_transactions *get_transactions(HitakiEfwProtocol *self)
+{
+    static GMutex creation_lock;
+    struct efw_transactions *transactions;
+
+    transactions = peek_transactions(self);
+    if (transactions == NULL) {
+        g_mutex_lock(&creation_lock);
+        transactions = peek_transactions(self);
+        if (transactions == NULL) {
+            transactions = g_new0(struct efw_transactions, 1);
+            g_mutex_init(&transactions->lock);
+            transactions->pendings = g_hash_table_new(g_direct_hash, g_direct_equal);
+            transactions->latencies = g_hash_table_new_full(efw_latency_hash, efw_latency_equal,
+                                                            g_free, NULL);
+            g_object_set_qdata_full(G_OBJECT(self), efw_transactions_quark(), transactions,
+                                    efw_transactions_free);
+        }
+        g_mutex_unlock(&creation_lock);
     }
 
-    // This comes from hardware specification.
-    *resp_seqnum = seqnum + 1;
+    return transactions;
+}
+
+static void pending_free(gpointer data)
+{
+    struct efw_pending *pending = (struct efw_pending *)data;
 
-    return iface->transmit_request(self, buf, length, error);
+    if (pending->timeout_source != NULL)
+        g_source_unref(pending->timeout_source);
+    if (pending->cancel_source != NULL)
+        g_source_unref(pending->cancel_source);
+    g_free(pending);
 }
 
-static void handle_response(HitakiEfwProtocol *self, const struct snd_efw_transaction *frame,
-                            guint32 *params, unsigned int param_count)
+// The sources are attached under the lock so that they are never dispatched for the pending entry
+// before registered. The entry with the sequence number used by the other entry is refused, since
+// replacing the other entry leaves it without completion.
+static gboolean register_pending(struct efw_transactions *transactions,
+                                 struct efw_pending *pending, GError **error)
+{
+    gpointer key = GUINT_TO_POINTER(pending->seqnum);
+
+    pending->start_time = g_get_monotonic_time();
+
+    g_mutex_lock(&transactions->lock);
+    if (g_hash_table_contains(transactions->pendings, key)) {
+        g_mutex_unlock(&transactions->lock);
+        generate_efw_protocol_error(error, HITAKI_EFW_PROTOCOL_ERROR_BAD);
+        return FALSE;
+    }
+    g_hash_table_insert(transactions->pendings, key, pending);
+    if (pending->task != NULL) {
+        GMainContext *context = g_task_get_context(pending->task);
+
+        g_source_attach(pending->timeout_source, context);
+        if (pending->cancel_source != NULL)
+            g_source_attach(pending->cancel_source, context);
+    }
+    g_mutex_unlock(&transactions->lock);
+
+    return TRUE;
+}
+
+// The caller which unregisters the pending entry successfully is responsible for completion.
+static gboolean unregister_pending(struct efw_transactions *transactions,
+                                   struct efw_pending *pending)
+{
+    gpointer key = GUINT_TO_POINTER(pending->seqnum);
+    gboolean found;
+
+    g_mutex_lock(&transactions->lock);
+    found = g_hash_table_lookup(transactions->pendings, key) == pending;
+    if (found)
+        g_hash_table_remove(transactions->pendings, key);
+    g_mutex_unlock(&transactions->lock);
+
+    return found;
+}
+
+// The lock should be held.
+static struct efw_latency *lookup_latency(struct efw_transactions *transactions,
+                                          guint32 category, guint32 command)
+{
+    struct efw_latency key = {
+        .category = category,
+        .command = command,
+    };
+    struct efw_latency *latency;
+
+    latency = g_hash_table_lookup(transactions->latencies, &key);
+    if (latency == NULL) {
+        latency = g_new0(struct efw_latency, 1);
+        latency->category = category;
+        latency->command = command;
+        g_hash_table_add(transactions->latencies, latency);
+    }
+
+    return latency;
+}
+
+static void record_round_trip(struct efw_transactions *transactions,
+                              const struct efw_pending *pending, HitakiEfwProtocolError status)
+{
+    gint64 elapsed = g_get_monotonic_time() - pending->start_time;
+    struct efw_latency *latency;
+    guint bucket = 0;
+
+    if (elapsed > 0)
+        bucket = MIN(g_bit_storage(elapsed), LATENCY_BUCKET_COUNT - 1);
+
+    g_mutex_lock(&transactions->lock);
+    latency = lookup_latency(transactions, pending->category, pending->command);
+    ++latency->histogram[bucket];
+    if (status != HITAKI_EFW_PROTOCOL_ERROR_OK)
+        ++latency->error_count;
+    g_mutex_unlock(&transactions->lock);
+}
+
+static void record_timeout(struct efw_transactions *transactions,
+                           const struct efw_pending *pending)
+{
+    struct efw_latency *latency;
+
+    g_mutex_lock(&transactions->lock);
+    latency = lookup_latency(transactions, pending->category, pending->command);
+    ++latency->timeout_count;
+    g_mutex_unlock(&transactions->lock);
+}
+
+static struct efw_pending *take_pending(struct efw_transactions *transactions, guint32 seqnum,
+                                        guint32 category, guint32 command)
+{
+    gpointer key = GUINT_TO_POINTER(seqnum);
+    struct efw_pending *pending;
+
+    g_mutex_lock(&transactions->lock);
+    pending = g_hash_table_lookup(transactions->pendings, key);
+    if (pending != NULL) {
+        if (pending->category == category && pending->command == command)
+            g_hash_table_remove(transactions->pendings, key);
+        else
+            pending = NULL;
+    }
+    g_mutex_unlock(&transactions->lock);
+
+    return pending;
+}
+
+// The parameters in response are converted just once into the buffer selected by the hook. The
+// buffer is the result for asynchronous call, or the one given by the caller of synchronous call.
+static guint32 *prepare_task_buffer(struct efw_pending *pending, HitakiEfwProtocolError status,
+                                    unsigned int param_count)
+{
+    struct efw_result *result;
+
+    result = g_malloc(sizeof(*result) + sizeof(*result->params) * param_count);
+    result->param_count = param_count;
+    pending->result = result;
+
+    return result->params;
+}
+
+static guint32 *prepare_waiter_buffer(struct efw_pending *pending, HitakiEfwProtocolError status,
+                                      unsigned int param_count)
+{
+    if (status == HITAKI_EFW_PROTOCOL_ERROR_OK && pending->params != NULL &&
+        pending->capacity >= param_count)
+        return pending->params;
+
+    return NULL;
+}
+
+static void complete_task(struct efw_pending *pending, HitakiEfwProtocolError status,
+                          unsigned int param_count)
+{
+    GTask *task = pending->task;
+    struct efw_result *result = pending->result;
+
+    result->status = status;
+    pending->result = NULL;
+
+    TRACE_PROBE3(efw_task_complete, pending->seqnum, status, param_count);
+
+    g_source_destroy(pending->timeout_source);
+    if (pending->cancel_source != NULL)
+        g_source_destroy(pending->cancel_source);
+
+    g_task_return_pointer(task, result, g_free);
+
+    // Release the reference owned by the table.
+    g_object_unref(task);
+}
+
+// The parameters are already in the buffer given by the caller.
+static void wake_waiter(struct efw_pending *pending, HitakiEfwProtocolError status,
+                        unsigned int param_count)
+{
+    struct efw_waiter *waiter = pending->waiter;
+
+    g_mutex_lock(&waiter->mutex);
+    pending->status = status;
+    pending->param_count = param_count;
+    if (status == HITAKI_EFW_PROTOCOL_ERROR_OK && param_count > 0 &&
+        (pending->params == NULL || pending->capacity < param_count))
+        pending->status = HITAKI_EFW_PROTOCOL_ERROR_BAD_QUAD_COUNT;
+    pending->is_done = TRUE;
+    --waiter->remaining;
+    // The entry is released by the waiter once woken up.
+    TRACE_PROBE3(efw_waiter_wakeup, pending->seqnum, pending->status, param_count);
+    g_cond_broadcast(&waiter->cond);
+    g_mutex_unlock(&waiter->mutex);
+}
+
+// Wait for completion of the pending entries till expiration. The entries left at expiration are
+// unregistered. The entry being completed by the response at the same time is waited for.
+static void wait_pendings(struct efw_waiter *waiter, struct efw_pending *pendings, guint count,
+                          gint64 expiration)
+{
+    int i;
+
+    g_mutex_lock(&waiter->mutex);
+    while (waiter->remaining > 0) {
+        if (!g_cond_wait_until(&waiter->cond, &waiter->mutex, expiration))
+            break;
+    }
+    g_mutex_unlock(&waiter->mutex);
+
+    for (i = 0; i < count; ++i) {
+        struct efw_pending *pending = pendings + i;
+
+        if (unregister_pending(pending->transactions, pending)) {
+            // The expiration is zero when the transmission fails.
+            if (expiration > 0)
+                record_timeout(pending->transactions, pending);
+            continue;
+        }
+
+        g_mutex_lock(&waiter->mutex);
+        while (!pending->is_done)
+            g_cond_wait(&waiter->cond, &waiter->mutex);
+        g_mutex_unlock(&waiter->mutex);
+    }
+}
+
+static gboolean handle_timeout(gpointer user_data)
+{
+    GTask *task = (GTask *)user_data;
+    struct efw_pending *pending = g_task_get_task_data(task);
+
+    if (unregister_pending(pending->transactions, pending)) {
+        GError *error = NULL;
+
+        record_timeout(pending->transactions, pending);
+
+        if (pending->cancel_source != NULL)
+            g_source_destroy(pending->cancel_source);
+
+        generate_efw_protocol_error(&error, HITAKI_EFW_PROTOCOL_ERROR_TIMEOUT);
+        g_task_return_error(task, error);
+        g_object_unref(task);
+    }
+
+    return G_SOURCE_REMOVE;
+}
+
+static gboolean handle_cancel(GCancellable *cancellable, gpointer user_data)
+{
+    GTask *task = (GTask *)user_data;
+    struct efw_pending *pending = g_task_get_task_data(task);
+
+    if (unregister_pending(pending->transactions, pending)) {
+        g_source_destroy(pending->timeout_source);
+        g_task_return_error_if_cancelled(task);
+        g_object_unref(task);
+    }
+
+    return G_SOURCE_REMOVE;
+}
+
+// Return TRUE when the signal is emitted.
+static gboolean handle_response(HitakiEfwProtocol *self, const struct snd_efw_transaction *frame,
+                                guint32 *params, unsigned int param_count)
 {
     unsigned int version = GUINT32_FROM_BE(frame->version);
     unsigned int seqnum = GUINT32_FROM_BE(frame->seqnum);
     unsigned int category = GUINT32_FROM_BE(frame->category);
     unsigned int command = GUINT32_FROM_BE(frame->command);
     unsigned int status = GUINT32_FROM_BE(frame->status);
-    int i;
+    struct efw_transactions *transactions;
+    struct efw_pending *pending = NULL;
+    guint32 *buf = NULL;
+    gboolean has_handler;
+
+    transactions = peek_transactions(self);
+    if (transactions != NULL)
+        pending = take_pending(transactions, seqnum, category, command);
+
+    TRACE_PROBE6(efw_response, self, seqnum, category, command, status, pending != NULL);
+
+    has_handler = HITAKI_EFW_PROTOCOL_GET_IFACE(self)->responded != NULL ||
+                  g_signal_has_handler_pending(self, efw_protocol_sigs[EFW_PROTOCOL_SIG_RESPONDED],
+                                               0, FALSE);
+
+    // Skip marshalling when nothing receives the response.
+    if (pending == NULL && !has_handler)
+        return FALSE;
 
     switch (status) {
     case HITAKI_EFW_PROTOCOL_ERROR_OK:
@@ -216,11 +644,52 @@ static void handle_response(HitakiEfwProtocol *self, const struct snd_efw_transa
         break;
     }
 
-    for (i = 0; i < param_count; ++i)
-        params[i] = GUINT32_FROM_BE(frame->params[i]);
+    if (pending != NULL) {
+        record_round_trip(transactions, pending, status);
+        buf = pending->prepare_buffer(pending, status, param_count);
+    }
+    if (buf == NULL && has_handler)
+        buf = params;
+
+    if (buf != NULL)
+        quadlets_from_be(buf, frame->params, param_count);
 
-    g_signal_emit_by_name(self, RESPONDED_EVENT_NAME, version, seqnum, category, command, status,
-                          params, param_count);
+    // The buffer for pending entry is available till the completion.
+    if (has_handler) {
+        TRACE_PROBE2(signal_emit_entry, self, RESPONDED_EVENT_NAME);
+        g_signal_emit(self, efw_protocol_sigs[EFW_PROTOCOL_SIG_RESPONDED], 0, version, seqnum,
+                      category, command, status, buf, param_count);
+        TRACE_PROBE2(signal_emit_exit, self, RESPONDED_EVENT_NAME);
+    }
+
+    if (pending != NULL)
+        pending->complete(pending, status, param_count);
+
+    return has_handler;
+}
+
+// The frame with invalid length is not parsed anymore, while the pending entry for it is completed
+// with the error so that the caller does not wait till timeout.
+static void reject_response(HitakiEfwProtocol *self, const struct snd_efw_transaction *frame)
+{
+    unsigned int seqnum = GUINT32_FROM_BE(frame->seqnum);
+    unsigned int category = GUINT32_FROM_BE(frame->category);
+    unsigned int command = GUINT32_FROM_BE(frame->command);
+    HitakiEfwProtocolError status = HITAKI_EFW_PROTOCOL_ERROR_BAD_QUAD_COUNT;
+    struct efw_transactions *transactions;
+    struct efw_pending *pending = NULL;
+
+    transactions = peek_transactions(self);
+    if (transactions != NULL)
+        pending = take_pending(transactions, seqnum, category, command);
+
+    TRACE_PROBE6(efw_response, self, seqnum, category, command, status, pending != NULL);
+
+    if (pending != NULL) {
+        record_round_trip(transactions, pending, status);
+        pending->prepare_buffer(pending, status, 0);
+        pending->complete(pending, status, 0);
+    }
 }
 
 /**
@@ -236,60 +705,38 @@ static void handle_response(HitakiEfwProtocol *self, const struct snd_efw_transa
 void hitaki_efw_protocol_receive_response(HitakiEfwProtocol *self, const guint8 *buffer,
                                           gsize length)
 {
-    guint32 params[MAXIMUM_FRAME_QUADLETS];
-
     g_return_if_fail(buffer != NULL && length > 0);
 
+    (void)efw_protocol_receive_response(self, buffer, length);
+}
+
+// Return the number of emitted signals so that the implementation can count them.
+guint efw_protocol_receive_response(HitakiEfwProtocol *self, const guint8 *buffer, gsize length)
+{
+    guint32 params[MAXIMUM_FRAME_QUADLETS];
+    guint emitted = 0;
+
     while (length >= HEADER_SIZE) {
         const struct snd_efw_transaction *frame = (const struct snd_efw_transaction *)buffer;
         unsigned int quadlet_count;
         unsigned int param_count;
 
         quadlet_count = GUINT32_FROM_BE(frame->length);
+        if (quadlet_count < HEADER_QUADLET_COUNT || quadlet_count > MAXIMUM_FRAME_QUADLETS ||
+            quadlet_count * sizeof(__be32) > length) {
+            reject_response(self, frame);
+            break;
+        }
 
         param_count = quadlet_count - HEADER_QUADLET_COUNT;
-        handle_response(self, frame, params, param_count);
+        if (handle_response(self, frame, params, param_count))
+            ++emitted;
 
         buffer += quadlet_count * sizeof(__be32);
         length -= quadlet_count * sizeof(__be32);
     }
-}
-
-struct waiter {
-    guint32 seqnum;
-
-    guint32 category;
-    guint32 command;
-    guint32 status;
-    guint32 *params;
-    gsize *param_count;
-
-    GCond cond;
-    GMutex mutex;
-};
 
-static void handle_signal(HitakiEfwProtocol *self, guint version, guint seqnum, guint category,
-                          guint command, HitakiEfwProtocolError status,
-                          const guint32 *params, guint param_count, gpointer user_data)
-{
-    struct waiter *w = (struct waiter *)user_data;
-
-    if (seqnum == w->seqnum && category == w->category && command == w->command) {
-        g_mutex_lock(&w->mutex);
-        w->status = status;
-        if (status == HITAKI_EFW_PROTOCOL_ERROR_OK) {
-            if (param_count > 0) {
-                if (w->param_count != NULL && *w->param_count >= param_count && w->params != NULL) {
-                    memcpy(w->params, params, sizeof(*params) * param_count);
-                    *w->param_count = param_count;
-                } else {
-                    w->status = HITAKI_EFW_PROTOCOL_ERROR_BAD_QUAD_COUNT;
-                }
-            }
-        }
-        g_cond_signal(&w->cond);
-        g_mutex_unlock(&w->mutex);
-    }
+    return emitted;
 }
 
 /**
@@ -320,48 +767,60 @@ gboolean hitaki_efw_protocol_transaction(HitakiEfwProtocol *self, guint category
                                     guint32 *const *params, gsize *param_count,
                                     guint timeout_ms, GError **error)
 {
-    struct waiter w;
-    gulong handler_id;
+    struct efw_waiter w;
+    struct efw_pending pending = { 0 };
     guint64 expiration;
+    guint32 seqnum;
 
     g_return_val_if_fail(HITAKI_IS_EFW_PROTOCOL(self), FALSE);
     g_return_val_if_fail(param_count == NULL || *param_count == 0 ||
                          (params != NULL && *params != NULL), FALSE);
     g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
 
-    w.category = category;
-    w.command = command;
-    w.status = HITAKI_EFW_PROTOCOL_ERROR_INVALID;
-    if (param_count != NULL && *param_count > 0 && params != NULL && *params != NULL) {
-        w.params = *params;
-        w.param_count = param_count;
-    } else {
-        w.params = NULL;
-        w.param_count = NULL;
-    }
     g_cond_init(&w.cond);
     g_mutex_init(&w.mutex);
+    w.remaining = 1;
 
-    handler_id = g_signal_connect(self, RESPONDED_EVENT_NAME, G_CALLBACK(handle_signal), &w);
+    pending.transactions = get_transactions(self);
+    pending.category = category;
+    pending.command = command;
+    pending.prepare_buffer = prepare_waiter_buffer;
+    pending.complete = wake_waiter;
+    pending.waiter = &w;
+    pending.status = HITAKI_EFW_PROTOCOL_ERROR_INVALID;
+    if (param_count != NULL && *param_count > 0 && params != NULL && *params != NULL) {
+        pending.params = *params;
+        pending.capacity = *param_count;
+    }
 
-    expiration = g_get_monotonic_time() + timeout_ms * G_TIME_SPAN_MILLISECOND;
+    HITAKI_EFW_PROTOCOL_GET_IFACE(self)->get_seqnum(self, &seqnum);
 
-    if (!hitaki_efw_protocol_transmit_request(self, category, command, args, arg_count, &w.seqnum,
-                                              error)) {
-        g_signal_handler_disconnect(self, handler_id);
+    // This comes from hardware specification.
+    pending.seqnum = seqnum + 1;
+
+    if (!register_pending(pending.transactions, &pending, error)) {
+        g_mutex_clear(&w.mutex);
+        g_cond_clear(&w.cond);
         return FALSE;
     }
 
-    g_mutex_lock(&w.mutex);
-    while (w.status == HITAKI_EFW_PROTOCOL_ERROR_INVALID) {
-        if (!g_cond_wait_until(&w.cond, &w.mutex, expiration))
-            break;
+    expiration = g_get_monotonic_time() + timeout_ms * G_TIME_SPAN_MILLISECOND;
+
+    if (!transmit_frame(self, seqnum, category, command, args, arg_count, error)) {
+        wait_pendings(&w, &pending, 1, 0);
+        g_mutex_clear(&w.mutex);
+        g_cond_clear(&w.cond);
+        return FALSE;
     }
-    g_signal_handler_disconnect(self, handler_id);
-    g_mutex_unlock(&w.mutex);
 
-    switch (w.status) {
+    wait_pendings(&w, &pending, 1, expiration);
+    g_mutex_clear(&w.mutex);
+    g_cond_clear(&w.cond);
+
+    switch (pending.status) {
     case HITAKI_EFW_PROTOCOL_ERROR_OK:
+        if (pending.param_count > 0)
+            *param_count = pending.param_count;
         return TRUE;
     case HITAKI_EFW_PROTOCOL_ERROR_BAD:
     case HITAKI_EFW_PROTOCOL_ERROR_BAD_COMMAND:
@@ -380,10 +839,475 @@ gboolean hitaki_efw_protocol_transaction(HitakiEfwProtocol *self, guint category
     case HITAKI_EFW_PROTOCOL_ERROR_BAD_PARAMETER:
     case HITAKI_EFW_PROTOCOL_ERROR_INCOMPLETE:
     case HITAKI_EFW_PROTOCOL_ERROR_INVALID:
-        generate_efw_protocol_error(error, w.status);
+        generate_efw_protocol_error(error, pending.status);
         return FALSE;
     default:
         generate_efw_protocol_error(error, HITAKI_EFW_PROTOCOL_ERROR_INVALID);
         return FALSE;
     }
 }
+
+/**
+ * hitaki_efw_protocol_transaction_batch:
+ * @self: A [iface@EfwProtocol].
+ * @requests: (array length=request_count): An array with quadlet elements for the sequence of
+ *            requests. Each request consists of category, command, the number of arguments, and
+ *            the arguments.
+ * @request_count: The number of quadlets in the requests array.
+ * @responses: (array length=response_count) (inout): An array with quadlet elements to save the
+ *             sequence of responses in the order of requests. Each response consists of status,
+ *             the number of parameters, and the parameters. Callers should give it for buffer
+ *             with enough space since this library performs no reallocation.
+ * @response_count: The number of quadlets in the responses array.
+ * @timeout_ms: The timeout to wait for all of responses.
+ * @error: A [struct@GLib.Error] with Hitaki.EfwProtocolError domain.
+ *
+ * Compose request frames of Echo Efw protocol for the sequence of requests into one buffer,
+ * transfer all of them without waiting for any response, then wait for all of responses. The
+ * round trips of transactions are overlapped, thus it is efficient to operate many commands. The
+ * status of the request without response within the timeout is
+ * [enum@Hitaki.EfwProtocolError.INVALID] in the responses array. The sequence of requests is
+ * rejected with [enum@Hitaki.EfwProtocolError.BAD_QUAD_COUNT] when it includes more requests than
+ * the sequence numbers available at the same time.
+ *
+ * Returns: TRUE if responses arrive for all of requests, else FALSE.
+ */
+gboolean hitaki_efw_protocol_transaction_batch(HitakiEfwProtocol *self,
+                                               const guint32 *requests, gsize request_count,
+                                               guint32 *const *responses, gsize *response_count,
+                                               guint timeout_ms, GError **error)
+{
+    HitakiEfwProtocolInterface *iface;
+    struct efw_transactions *transactions;
+    struct efw_pending *pendings;
+    struct efw_waiter w;
+    guint32 *scratch;
+    guint8 *frames;
+    gsize *lengths;
+    guint64 expiration;
+    guint32 base_seqnum;
+    gboolean is_reserved;
+    gboolean is_complete;
+    gsize pos, offset;
+    guint count, registered;
+    int i;
+
+    g_return_val_if_fail(HITAKI_IS_EFW_PROTOCOL(self), FALSE);
+    g_return_val_if_fail(request_count == 0 || requests != NULL, FALSE);
+    g_return_val_if_fail(responses != NULL && *responses != NULL, FALSE);
+    g_return_val_if_fail(response_count != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    count = 0;
+    pos = 0;
+    while (pos < request_count) {
+        gsize arg_count;
+
+        if (count >= MAXIMUM_BATCH_FRAMES || request_count - pos < 3) {
+            generate_efw_protocol_error(error, HITAKI_EFW_PROTOCOL_ERROR_BAD_QUAD_COUNT);
+            return FALSE;
+        }
+
+        arg_count = requests[pos + 2];
+        if (arg_count > MAXIMUM_PARAM_QUADLETS || request_count - pos - 3 < arg_count) {
+            generate_efw_protocol_error(error, HITAKI_EFW_PROTOCOL_ERROR_BAD_QUAD_COUNT);
+            return FALSE;
+        }
+
+        pos += 3 + arg_count;
+        ++count;
+    }
+
+    if (count == 0) {
+        *response_count = 0;
+        return TRUE;
+    }
+
+    iface = HITAKI_EFW_PROTOCOL_GET_IFACE(self);
+    transactions = get_transactions(self);
+
+    is_reserved = iface->reserve_seqnums != NULL;
+    if (is_reserved && !iface->reserve_seqnums(self, count, &base_seqnum)) {
+        generate_efw_protocol_error(error, HITAKI_EFW_PROTOCOL_ERROR_BAD_QUAD_COUNT);
+        return FALSE;
+    }
+
+    g_cond_init(&w.cond);
+    g_mutex_init(&w.mutex);
+    w.remaining = count;
+
+    pendings = g_new0(struct efw_pending, count);
+    scratch = g_new(guint32, count * MAXIMUM_PARAM_QUADLETS);
+    frames = g_malloc(count * MAXIMUM_FRAME_BYTES);
+    lengths = g_new(gsize, count);
+
+    // Compose all of request frames in one buffer and register pending entries in advance.
+    pos = 0;
+    registered = 0;
+    for (i = 0; i < count; ++i) {
+        struct efw_pending *pending = pendings + i;
+        const guint32 *args = requests + pos + 3;
+        gsize arg_count = requests[pos + 2];
+        guint32 seqnum;
+
+        if (is_reserved)
+            seqnum = base_seqnum + i * 2;
+        else
+            iface->get_seqnum(self, &seqnum);
+
+        lengths[i] = compose_frame(frames + i * MAXIMUM_FRAME_BYTES, seqnum, requests[pos],
+                                   requests[pos + 1], args, arg_count);
+
+        pending->transactions = transactions;
+        // This comes from hardware specification.
+        pending->seqnum = seqnum + 1;
+        pending->category = requests[pos];
+        pending->command = requests[pos + 1];
+        pending->prepare_buffer = prepare_waiter_buffer;
+        pending->complete = wake_waiter;
+        pending->waiter = &w;
+        pending->status = HITAKI_EFW_PROTOCOL_ERROR_INVALID;
+        pending->params = scratch + i * MAXIMUM_PARAM_QUADLETS;
+        pending->capacity = MAXIMUM_PARAM_QUADLETS;
+
+        if (!register_pending(transactions, pending, error))
+            break;
+        ++registered;
+
+        pos += 3 + arg_count;
+    }
+
+    // The entries registered so far are unregistered without transmission when any of them is
+    // refused.
+    expiration = 0;
+    if (registered == count) {
+        expiration = g_get_monotonic_time() + timeout_ms * G_TIME_SPAN_MILLISECOND;
+
+        // The driver accepts one frame per write operation.
+        for (i = 0; i < count; ++i) {
+            TRACE_PROBE4(efw_transmit_request, self, pendings[i].seqnum - 1,
+                         pendings[i].category, pendings[i].command);
+            if (!iface->transmit_request(self, frames + i * MAXIMUM_FRAME_BYTES, lengths[i],
+                                         error)) {
+                expiration = 0;
+                break;
+            }
+        }
+    }
+
+    wait_pendings(&w, pendings, registered, expiration);
+    g_mutex_clear(&w.mutex);
+    g_cond_clear(&w.cond);
+
+    if (expiration == 0) {
+        g_free(lengths);
+        g_free(frames);
+        g_free(scratch);
+        g_free(pendings);
+        return FALSE;
+    }
+
+    is_complete = TRUE;
+    offset = 0;
+    for (i = 0; i < count; ++i) {
+        const struct efw_pending *pending = pendings + i;
+        gsize param_count = 0;
+
+        if (!pending->is_done)
+            is_complete = FALSE;
+        else if (pending->status == HITAKI_EFW_PROTOCOL_ERROR_OK)
+            param_count = pending->param_count;
+
+        if (*response_count < offset + 2 + param_count) {
+            generate_efw_protocol_error(error, HITAKI_EFW_PROTOCOL_ERROR_BAD_QUAD_COUNT);
+            break;
+        }
+
+        (*responses)[offset] = (guint32)pending->status;
+        (*responses)[offset + 1] = param_count;
+        memcpy(*responses + offset + 2, pending->params, sizeof(*pending->params) * param_count);
+        offset += 2 + param_count;
+    }
+
+    g_free(lengths);
+    g_free(frames);
+    g_free(scratch);
+    g_free(pendings);
+
+    if (i < count)
+        return FALSE;
+
+    *response_count = offset;
+
+    if (!is_complete) {
+        generate_efw_protocol_error(error, HITAKI_EFW_PROTOCOL_ERROR_INCOMPLETE);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/**
+ * hitaki_efw_protocol_transaction_async:
+ * @self: A [iface@EfwProtocol].
+ * @category: One of category for the transaction.
+ * @command: One of commands for the transaction.
+ * @args: (array length=arg_count) (in) (nullable): An array with elements for quadlet data as
+ *        arguments for command.
+ * @arg_count: The number of quadlets in the args array.
+ * @timeout_ms: The timeout to wait for response.
+ * @cancellable: (nullable): A [class@Gio.Cancellable].
+ * @callback: (scope async): A [callback@Gio.AsyncReadyCallback] to call when the transaction
+ *            finishes.
+ * @user_data: (closure): The data to pass to the callback.
+ *
+ * Transfer asynchronous transaction for request frame of Echo Efw protocol and return immediately
+ * without waiting for response. The callback is called in the thread-default main context of the
+ * caller when the response arrives, the timeout expires, or the transaction is cancelled. Call
+ * [method@EfwProtocol.transaction_finish] in the callback to retrieve the result.
+ */
+void hitaki_efw_protocol_transaction_async(HitakiEfwProtocol *self, guint category, guint command,
+                                           const guint32 *args, gsize arg_count, guint timeout_ms,
+                                           GCancellable *cancellable, GAsyncReadyCallback callback,
+                                           gpointer user_data)
+{
+    struct efw_pending *pending;
+    GError *error = NULL;
+    guint32 seqnum;
+    GTask *task;
+
+    g_return_if_fail(HITAKI_IS_EFW_PROTOCOL(self));
+    g_return_if_fail(arg_count == 0 || args != NULL);
+
+    task = g_task_new(self, cancellable, callback, user_data);
+    g_task_set_source_tag(task, hitaki_efw_protocol_transaction_async);
+
+    if (g_task_return_error_if_cancelled(task)) {
+        g_object_unref(task);
+        return;
+    }
+
+    pending = g_new0(struct efw_pending, 1);
+    g_task_set_task_data(task, pending, pending_free);
+
+    pending->transactions = get_transactions(self);
+    pending->category = category;
+    pending->command = command;
+    pending->prepare_buffer = prepare_task_buffer;
+    pending->complete = complete_task;
+    pending->task = task;
+
+    pending->timeout_source = g_timeout_source_new(timeout_ms);
+    g_source_set_callback(pending->timeout_source, handle_timeout, g_object_ref(task),
+                          g_object_unref);
+
+    if (cancellable != NULL) {
+        pending->cancel_source = g_cancellable_source_new(cancellable);
+        g_source_set_callback(pending->cancel_source, (GSourceFunc)handle_cancel,
+                              g_object_ref(task), g_object_unref);
+    }
+
+    HITAKI_EFW_PROTOCOL_GET_IFACE(self)->get_seqnum(self, &seqnum);
+
+    // This comes from hardware specification.
+    pending->seqnum = seqnum + 1;
+
+    // The reference of task is owned by the table till completion.
+    if (!register_pending(pending->transactions, pending, &error)) {
+        // The sources are not attached, thus release them and the references to task in their
+        // callbacks.
+        g_clear_pointer(&pending->timeout_source, g_source_unref);
+        g_clear_pointer(&pending->cancel_source, g_source_unref);
+        g_task_return_error(task, error);
+        g_object_unref(task);
+        return;
+    }
+
+    if (!transmit_frame(self, seqnum, category, command, args, arg_count, &error)) {
+        if (unregister_pending(pending->transactions, pending)) {
+            g_source_destroy(pending->timeout_source);
+            if (pending->cancel_source != NULL)
+                g_source_destroy(pending->cancel_source);
+            g_task_return_error(task, error);
+            g_object_unref(task);
+        } else {
+            g_error_free(error);
+        }
+    }
+}
+
+/**
+ * hitaki_efw_protocol_transaction_finish:
+ * @self: A [iface@EfwProtocol].
+ * @result: A [iface@Gio.AsyncResult].
+ * @params: (array length=param_count) (inout) (nullable): An array with elements for quadlet data
+ *          to save parameters in response. Callers should give it for buffer with enough space
+ *          against the request since this library performs no reallocation. Due to the reason, the
+ *          value of this argument should point to the pointer to the array and immutable. The
+ *          content of array is mutable for parameters in response.
+ * @param_count: The number of quadlets in the params array.
+ * @error: A [struct@GLib.Error] with Hitaki.EfwProtocolError domain, or Gio.IOErrorEnum domain
+ *         when the transaction is cancelled.
+ *
+ * Finish the transaction started by [method@EfwProtocol.transaction_async] and retrieve the
+ * parameters in response.
+ *
+ * Returns: TRUE if the overall operation finished successfully, else FALSE.
+ */
+gboolean hitaki_efw_protocol_transaction_finish(HitakiEfwProtocol *self, GAsyncResult *result,
+                                                guint32 *const *params, gsize *param_count,
+                                                GError **error)
+{
+    struct efw_result *res;
+    HitakiEfwProtocolError status;
+
+    g_return_val_if_fail(HITAKI_IS_EFW_PROTOCOL(self), FALSE);
+    g_return_val_if_fail(g_task_is_valid(result, self), FALSE);
+    g_return_val_if_fail(param_count == NULL || *param_count == 0 ||
+                         (params != NULL && *params != NULL), FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    res = g_task_propagate_pointer(G_TASK(result), error);
+    if (res == NULL)
+        return FALSE;
+
+    status = res->status;
+    if (status == HITAKI_EFW_PROTOCOL_ERROR_OK && res->param_count > 0) {
+        if (param_count != NULL && *param_count >= res->param_count &&
+            params != NULL && *params != NULL) {
+            memcpy(*params, res->params, sizeof(*res->params) * res->param_count);
+            *param_count = res->param_count;
+        } else {
+            status = HITAKI_EFW_PROTOCOL_ERROR_BAD_QUAD_COUNT;
+        }
+    }
+    g_free(res);
+
+    if (status != HITAKI_EFW_PROTOCOL_ERROR_OK) {
+        generate_efw_protocol_error(error, status);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/**
+ * hitaki_efw_protocol_get_recorded_commands:
+ * @self: A [iface@EfwProtocol].
+ * @commands: (array length=count) (out) (transfer full): An array with elements for the pairs of
+ *            category and command recorded by the transactions.
+ * @count: (out): The number of elements in the array, twice as many as the pairs.
+ *
+ * Retrieve the pairs of category and command for which [method@EfwProtocol.transaction],
+ * [method@EfwProtocol.transaction_batch], or [method@EfwProtocol.transaction_async] recorded the
+ * round trip time or the timeout.
+ */
+void hitaki_efw_protocol_get_recorded_commands(HitakiEfwProtocol *self, guint32 **commands,
+                                               gsize *count)
+{
+    struct efw_transactions *transactions;
+    GHashTableIter iter;
+    gpointer key;
+    gsize pos;
+
+    g_return_if_fail(HITAKI_IS_EFW_PROTOCOL(self));
+    g_return_if_fail(commands != NULL);
+    g_return_if_fail(count != NULL);
+
+    *commands = NULL;
+    *count = 0;
+
+    transactions = peek_transactions(self);
+    if (transactions == NULL)
+        return;
+
+    g_mutex_lock(&transactions->lock);
+    *count = g_hash_table_size(transactions->latencies) * 2;
+    if (*count > 0) {
+        *commands = g_new(guint32, *count);
+        pos = 0;
+        g_hash_table_iter_init(&iter, transactions->latencies);
+        while (g_hash_table_iter_next(&iter, &key, NULL)) {
+            const struct efw_latency *latency = key;
+
+            (*commands)[pos++] = latency->category;
+            (*commands)[pos++] = latency->command;
+        }
+    }
+    g_mutex_unlock(&transactions->lock);
+}
+
+/**
+ * hitaki_efw_protocol_get_latency_histogram:
+ * @self: A [iface@EfwProtocol].
+ * @category: One of category for the transaction.
+ * @command: One of commands for the transaction.
+ * @histogram: (array fixed-size=20) (inout): The array with elements for the buckets of histogram
+ *             for round trip time.
+ * @timeout_count: (out): The number of transactions without response within the timeout.
+ * @error_count: (out): The number of responses with status except for
+ *               [enum@Hitaki.EfwProtocolError.OK].
+ *
+ * Retrieve the record of transactions for the pair of category and command. The histogram counts
+ * the round trip time from the registration of request to the arrival of response, including the
+ * responses with error status. The first bucket counts the time less than one microsecond, and
+ * the n-th bucket counts the time between 2^(n-1) and 2^n - 1 microseconds. The last bucket counts
+ * the rest. All of the counts are zero when nothing is recorded for the pair.
+ */
+void hitaki_efw_protocol_get_latency_histogram(HitakiEfwProtocol *self, guint category,
+                                               guint command, guint64 *const histogram[20],
+                                               guint64 *timeout_count, guint64 *error_count)
+{
+    struct efw_transactions *transactions;
+    const struct efw_latency *latency = NULL;
+    struct efw_latency key = {
+        .category = category,
+        .command = command,
+    };
+
+    G_STATIC_ASSERT(LATENCY_BUCKET_COUNT == 20);
+
+    g_return_if_fail(HITAKI_IS_EFW_PROTOCOL(self));
+    g_return_if_fail(histogram != NULL && *histogram != NULL);
+    g_return_if_fail(timeout_count != NULL);
+    g_return_if_fail(error_count != NULL);
+
+    transactions = peek_transactions(self);
+    if (transactions != NULL) {
+        g_mutex_lock(&transactions->lock);
+        latency = g_hash_table_lookup(transactions->latencies, &key);
+        if (latency != NULL) {
+            memcpy(*histogram, latency->histogram, sizeof(latency->histogram));
+            *timeout_count = latency->timeout_count;
+            *error_count = latency->error_count;
+        }
+        g_mutex_unlock(&transactions->lock);
+    }
+
+    if (latency == NULL) {
+        memset(*histogram, 0, sizeof(**histogram) * LATENCY_BUCKET_COUNT);
+        *timeout_count = 0;
+        *error_count = 0;
+    }
+}
+
+/**
+ * hitaki_efw_protocol_reset_latency_histograms:
+ * @self: A [iface@EfwProtocol].
+ *
+ * Discard the records of transactions for all of the pairs of category and command.
+ */
+void hitaki_efw_protocol_reset_latency_histograms(HitakiEfwProtocol *self)
+{
+    struct efw_transactions *transactions;
+
+    g_return_if_fail(HITAKI_IS_EFW_PROTOCOL(self));
+
+    transactions = peek_transactions(self);
+    if (transactions == NULL)
+        return;
+
+    g_mutex_lock(&transactions->lock);
+    g_hash_table_remove_all(transactions->latencies);
+    g_mutex_unlock(&transactions->lock);
+}
@@ -58,6 +58,21 @@ struct _HitakiEfwProtocolInterface {
      */
     void (*responded)(HitakiEfwProtocol *self, guint version, guint seqnum, guint category,
                       guint command, HitakiEfwProtocolError status, const guint32 *params, guint param_count);
+
+    /**
+     * HitakiEfwProtocolInterface::reserve_seqnums:
+     * @self: A [iface@EfwProtocol].
+     * @count: The number of sequence numbers to reserve.
+     * @seqnum: (out): The first sequence number in the reserved range.
+     *
+     * Virtual function to reserve the range of sequence numbers for request frames of transactions
+     * at once. The sequence numbers in the range are incremented by 2 from the first one without
+     * wrapping around. The implementation is optional and [vfunc@EfwProtocol.get_seqnum] is used
+     * for each request frame when it is not implemented.
+     *
+     * Returns: TRUE if the range is reserved, else FALSE.
+     */
+    gboolean (*reserve_seqnums)(HitakiEfwProtocol *self, guint count, guint32 *seqnum);
 };
 
 gboolean hitaki_efw_protocol_transmit_request(HitakiEfwProtocol *self, guint category,
@@ -71,6 +86,29 @@ gboolean hitaki_efw_protocol_transaction(HitakiEfwProtocol *self, guint category
                                          guint32 *const *params, gsize *param_count,
                                          guint timeout_ms, GError **error);
 
+gboolean hitaki_efw_protocol_transaction_batch(HitakiEfwProtocol *self,
+                                               const guint32 *requests, gsize request_count,
+                                               guint32 *const *responses, gsize *response_count,
+                                               guint timeout_ms, GError **error);
+
+void hitaki_efw_protocol_transaction_async(HitakiEfwProtocol *self, guint category, guint command,
+                                           const guint32 *args, gsize arg_count, guint timeout_ms,
+                                           GCancellable *cancellable, GAsyncReadyCallback callback,
+                                           gpointer user_data);
+
+gboolean hitaki_efw_protocol_transaction_finish(HitakiEfwProtocol *self, GAsyncResult *result,
+                                                guint32 *const *params, gsize *param_count,
+                                                GError **error);
+
+void hitaki_efw_protocol_get_recorded_commands(HitakiEfwProtocol *self, guint32 **commands,
+                                               gsize *count);
+
+void hitaki_efw_protocol_get_latency_histogram(HitakiEfwProtocol *self, guint category,
+                                               guint command, guint64 *const histogram[20],
+                                               guint64 *timeout_count, guint64 *error_count);
+
+void hitaki_efw_protocol_reset_latency_histograms(HitakiEfwProtocol *self);
+
 G_END_DECLS
 
 #endif
@@ -12,4 +12,6 @@ static inline void generate_efw_protocol_error(GError **error, HitakiEfwProtocol
     g_set_error_literal(error, HITAKI_EFW_PROTOCOL_ERROR, code, label);
 }
 
+guint efw_protocol_receive_response(HitakiEfwProtocol *self, const guint8 *buffer, gsize length);
+
 #endif
@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#include "event_ring_private.h"
+
+#include <string.h>
+
+/**
+ * HitakiEventRing:
+ * A GObject-derived object for lock-free queue of decoded events.
+ *
+ * The [class@EventRing] is an object class derived from [class@GObject.Object] for the queue of
+ * decoded events with fixed size, preallocated at instantiation. The object is assigned to
+ * [property@AlsaFirewire:event-ring] property, then the events are pushed in the thread
+ * dispatching the source. The consumer thread pops the events by
+ * [method@EventRing.pop] without any lock nor memory allocation, thus it is available in the
+ * thread for real time processing. The queue supports single producer and single consumer. The
+ * events are discarded when the queue is full.
+ */
+
+// The producer and consumer update the indices in separate cache lines.
+#define CACHE_LINE_SIZE     64
+
+typedef struct {
+    struct unit_event *entries;
+    guint capacity;
+
+    guint8 padding0[CACHE_LINE_SIZE];
+    // Written by the producer.
+    guint head;
+    guint overrun_count;
+
+    guint8 padding1[CACHE_LINE_SIZE];
+    // Written by the consumer.
+    guint tail;
+} HitakiEventRingPrivate;
+
+G_DEFINE_TYPE_WITH_PRIVATE(HitakiEventRing, hitaki_event_ring, G_TYPE_OBJECT)
+
+enum event_ring_prop_type {
+    EVENT_RING_PROP_CAPACITY = 1,
+    EVENT_RING_PROP_OVERRUN_COUNT,
+    EVENT_RING_PROP_COUNT,
+};
+
+#define DEFAULT_CAPACITY    256
+
+static void event_ring_set_property(GObject *obj, guint id, const GValue *val, GParamSpec *spec)
+{
+    HitakiEventRing *self = HITAKI_EVENT_RING(obj);
+    HitakiEventRingPrivate *priv = hitaki_event_ring_get_instance_private(self);
+
+    switch (id) {
+    case EVENT_RING_PROP_CAPACITY:
+    {
+        guint capacity = g_value_get_uint(val);
+
+        // Round up to power of two so that the index is masked.
+        priv->capacity = 1;
+        while (priv->capacity < capacity)
+            priv->capacity <<= 1;
+        break;
+    }
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(obj, id, spec);
+        break;
+    }
+}
+
+static void event_ring_get_property(GObject *obj, guint id, GValue *val, GParamSpec *spec)
+{
+    HitakiEventRing *self = HITAKI_EVENT_RING(obj);
+    HitakiEventRingPrivate *priv = hitaki_event_ring_get_instance_private(self);
+
+    switch (id) {
+    case EVENT_RING_PROP_CAPACITY:
+        g_value_set_uint(val, priv->capacity);
+        break;
+    case EVENT_RING_PROP_OVERRUN_COUNT:
+        g_value_set_uint(val, g_atomic_int_get(&priv->overrun_count));
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(obj, id, spec);
+        break;
+    }
+}
+
+static void event_ring_constructed(GObject *obj)
+{
+    HitakiEventRing *self = HITAKI_EVENT_RING(obj);
+    HitakiEventRingPrivate *priv = hitaki_event_ring_get_instance_private(self);
+
+    priv->entries = g_new0(struct unit_event, priv->capacity);
+
+    G_OBJECT_CLASS(hitaki_event_ring_parent_class)->constructed(obj);
+}
+
+static void event_ring_finalize(GObject *obj)
+{
+    HitakiEventRing *self = HITAKI_EVENT_RING(obj);
+    HitakiEventRingPrivate *priv = hitaki_event_ring_get_instance_private(self);
+
+    g_free(priv->entries);
+
+    G_OBJECT_CLASS(hitaki_event_ring_parent_class)->finalize(obj);
+}
+
+static void hitaki_event_ring_class_init(HitakiEventRingClass *klass)
+{
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+
+    gobject_class->set_property = event_ring_set_property;
+    gobject_class->get_property = event_ring_get_property;
+    gobject_class->constructed = event_ring_constructed;
+    gobject_class->finalize = event_ring_finalize;
+
+    /**
+     * HitakiEventRing:capacity:
+     *
+     * The number of events which the queue can hold. It is rounded up to power of two.
+     */
+    g_object_class_install_property(gobject_class, EVENT_RING_PROP_CAPACITY,
+        g_param_spec_uint("capacity", "capacity",
+                          "The number of events which the queue can hold",
+                          1, G_MAXINT32 / sizeof(struct unit_event), DEFAULT_CAPACITY,
+                          G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY));
+
+    /**
+     * HitakiEventRing:overrun-count:
+     *
+     * The number of events discarded since the queue is full.
+     */
+    g_object_class_install_property(gobject_class, EVENT_RING_PROP_OVERRUN_COUNT,
+        g_param_spec_uint("overrun-count", "overrun-count",
+                          "The number of events discarded since the queue is full",
+                          0, G_MAXUINT, 0,
+                          G_PARAM_READABLE));
+}
+
+static void hitaki_event_ring_init(HitakiEventRing *self)
+{
+    HitakiEventRingPrivate *priv = hitaki_event_ring_get_instance_private(self);
+
+    priv->head = 0;
+    priv->tail = 0;
+    priv->overrun_count = 0;
+}
+
+/**
+ * hitaki_event_ring_new:
+ * @capacity: The number of events which the queue can hold.
+ *
+ * Instantiate [class@EventRing] object and return it.
+ *
+ * Returns: an instance of [class@EventRing].
+ */
+HitakiEventRing *hitaki_event_ring_new(guint capacity)
+{
+    return g_object_new(HITAKI_TYPE_EVENT_RING, "capacity", capacity, NULL);
+}
+
+// Never blocks. The event is discarded when the queue is full.
+void event_ring_push(HitakiEventRing *self, const struct unit_event *event)
+{
+    HitakiEventRingPrivate *priv = hitaki_event_ring_get_instance_private(self);
+    guint head = priv->head;
+    guint tail = g_atomic_int_get(&priv->tail);
+
+    if (head - tail >= priv->capacity) {
+        g_atomic_int_inc(&priv->overrun_count);
+        return;
+    }
+
+    priv->entries[head & (priv->capacity - 1)] = *event;
+    g_atomic_int_set(&priv->head, head + 1);
+}
+
+/**
+ * hitaki_event_ring_pop:
+ * @self: A [class@EventRing].
+ * @event: (inout): A [struct@UnitEvent] to which the oldest event in the queue is copied.
+ *
+ * Pop the oldest event in the queue without any lock nor memory allocation.
+ *
+ * Returns: TRUE if an event is popped, else FALSE when the queue is empty.
+ */
+gboolean hitaki_event_ring_pop(HitakiEventRing *self, HitakiUnitEvent *const *event)
+{
+    HitakiEventRingPrivate *priv;
+    guint head, tail;
+
+    g_return_val_if_fail(HITAKI_IS_EVENT_RING(self), FALSE);
+    g_return_val_if_fail(event != NULL && *event != NULL, FALSE);
+
+    priv = hitaki_event_ring_get_instance_private(self);
+
+    tail = priv->tail;
+    head = g_atomic_int_get(&priv->head);
+    if (tail == head)
+        return FALSE;
+
+    memcpy(*event, &priv->entries[tail & (priv->capacity - 1)], sizeof(**event));
+    g_atomic_int_set(&priv->tail, tail + 1);
+
+    return TRUE;
+}
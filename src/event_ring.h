@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#ifndef __HITAKI_EVENT_RING_H__
+#define __HITAKI_EVENT_RING_H__
+
+#include <hitaki.h>
+
+G_BEGIN_DECLS
+
+#define HITAKI_TYPE_EVENT_RING  (hitaki_event_ring_get_type())
+
+G_DECLARE_DERIVABLE_TYPE(HitakiEventRing, hitaki_event_ring, HITAKI, EVENT_RING, GObject);
+
+struct _HitakiEventRingClass {
+    GObjectClass parent_class;
+};
+
+HitakiEventRing *hitaki_event_ring_new(guint capacity);
+
+gboolean hitaki_event_ring_pop(HitakiEventRing *self, HitakiUnitEvent *const *event);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#ifndef __HITAKI_EVENT_RING_PRIVATE_H__
+#define __HITAKI_EVENT_RING_PRIVATE_H__
+
+#include "hitaki.h"
+
+#define UNIT_EVENT_VALUE_COUNT      6
+
+struct unit_event {
+    guint32 type;
+    guint32 card_id;
+    guint32 values[UNIT_EVENT_VALUE_COUNT];
+};
+
+G_STATIC_ASSERT(sizeof(struct unit_event) == sizeof(HitakiUnitEvent));
+
+void event_ring_push(HitakiEventRing *self, const struct unit_event *event);
+
+#endif
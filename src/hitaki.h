@@ -4,6 +4,7 @@
 
 #include <glib.h>
 #include <glib-object.h>
+#include <gio/gio.h>
 
 #include <hitaki_sigs_marshal.h>
 
@@ -11,7 +12,11 @@
 #include <hitaki_enums.h>
 
 #include <snd_motu_register_dsp_parameter.h>
+#include <unit_event.h>
 
+#include <event_ring.h>
+
+#include <alsa_firewire_stats.h>
 #include <alsa_firewire.h>
 #include <quadlet_notification.h>
 #include <timestamped_quadlet_notification.h>
@@ -28,4 +33,8 @@
 #include <snd_tascam.h>
 #include <snd_fireface.h>
 
+#include <alsa_firewire_mux.h>
+#include <motu_meter_sampler.h>
+#include <meter_processor.h>
+
 #endif
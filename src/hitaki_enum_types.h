@@ -100,6 +100,78 @@ typedef enum {
     HITAKI_EFW_PROTOCOL_ERROR_INVALID           = -1,   /* = 0xffffffff */
 } HitakiEfwProtocolError;
 
+/**
+ * HitakiUnitEventType:
+ * @HITAKI_UNIT_EVENT_TYPE_NOTIFIED:                    The notification with quadlet message
+ *                                                      from DICE, Digi00x, and MOTU units.
+ * @HITAKI_UNIT_EVENT_TYPE_NOTIFIED_AT:                 The notification with quadlet message and
+ *                                                      time stamp from Fireface units.
+ * @HITAKI_UNIT_EVENT_TYPE_TASCAM_CHANGED:              The change of state in TASCAM units.
+ * @HITAKI_UNIT_EVENT_TYPE_MOTU_REGISTER_DSP_CHANGED:   The change of parameter in MOTU register
+ *                                                      DSP models.
+ * @HITAKI_UNIT_EVENT_TYPE_EFW_RESPONDED:               The response of transaction in Fireworks
+ *                                                      protocol.
+ *
+ * The enumerations for type of event in [struct@UnitEvent].
+ */
+typedef enum {
+    HITAKI_UNIT_EVENT_TYPE_NOTIFIED = 0,
+    HITAKI_UNIT_EVENT_TYPE_NOTIFIED_AT,
+    HITAKI_UNIT_EVENT_TYPE_TASCAM_CHANGED,
+    HITAKI_UNIT_EVENT_TYPE_MOTU_REGISTER_DSP_CHANGED,
+    HITAKI_UNIT_EVENT_TYPE_EFW_RESPONDED,
+} HitakiUnitEventType;
+
+/**
+ * HitakiMotuRegisterDspParameterType:
+ * @HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_GAIN:          The gain of source to mixer.
+ * @HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_PAN:           The L/R balance of source
+ *                                                                      to mixer.
+ * @HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_FLAG:          The flag of mute and solo
+ *                                                                      for source to mixer.
+ * @HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_OUTPUT_PAIRED_VOLUME: The volume of paired
+ *                                                                      output from mixer.
+ * @HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_OUTPUT_PAIRED_FLAG:   The flag of paired output
+ *                                                                      from mixer.
+ * @HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MAIN_OUTPUT_PAIRED_VOLUME:  The volume of paired main
+ *                                                                      output.
+ * @HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_HP_OUTPUT_PAIRED_VOLUME:    The volume of paired
+ *                                                                      headphone output.
+ * @HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_HP_OUTPUT_PAIRED_ASSIGNMENT: The assignment of paired
+ *                                                                       headphone output.
+ * @HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_LINE_INPUT_BOOST:           The flags of boost for
+ *                                                                      line inputs.
+ * @HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_LINE_INPUT_NOMINAL_LEVEL:   The flags of nominal level
+ *                                                                      for line inputs.
+ * @HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_INPUT_GAIN_AND_INVERT:      The gain and invert of
+ *                                                                      input.
+ * @HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_INPUT_FLAG:                 The flag of input.
+ * @HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_PAIRED_BALANCE: The L/R balance of paired
+ *                                                                       source to mixer.
+ * @HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_PAIRED_WIDTH:  The width of paired source
+ *                                                                      to mixer.
+ *
+ * The enumerations for type of parameter changed in MOTU register DSP models. The value is the
+ * same as the type of encoded event in `sound/firewire/motu/motu-register-dsp-message-parser.c`
+ * in Linux kernel.
+ */
+typedef enum {
+    HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_GAIN           = 0x02,
+    HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_PAN            = 0x03,
+    HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_FLAG           = 0x04,
+    HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_OUTPUT_PAIRED_VOLUME  = 0x05,
+    HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_OUTPUT_PAIRED_FLAG    = 0x06,
+    HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MAIN_OUTPUT_PAIRED_VOLUME   = 0x07,
+    HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_HP_OUTPUT_PAIRED_VOLUME     = 0x08,
+    HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_HP_OUTPUT_PAIRED_ASSIGNMENT = 0x09,
+    HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_LINE_INPUT_BOOST            = 0x0d,
+    HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_LINE_INPUT_NOMINAL_LEVEL    = 0x0e,
+    HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_INPUT_GAIN_AND_INVERT       = 0x15,
+    HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_INPUT_FLAG                  = 0x16,
+    HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_PAIRED_BALANCE = 0x17,
+    HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_PAIRED_WIDTH   = 0x18,
+} HitakiMotuRegisterDspParameterType;
+
 G_END_DECLS
 
 #endif
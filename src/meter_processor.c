@@ -0,0 +1,509 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#include "hitaki.h"
+
+#include <math.h>
+#include <string.h>
+
+/**
+ * HitakiMeterProcessor:
+ * A GObject-derived object to process meter information into level for display.
+ *
+ * The [class@MeterProcessor] is an object class derived from [class@GObject.Object] to convert
+ * linear meter information into dBFS, then apply ballistics of attack and release, peak hold, and
+ * latch of clip over all of channels. The data is typically retrieved by
+ * [method@MotuCommandDsp.read_float_meter], [method@MotuRegisterDsp.read_byte_meter], or
+ * [class@MotuMeterSampler]. The time constants are applied according to the time stamp given for
+ * each call of processing.
+ */
+
+// The channels are processed by vector with four lanes, padded to the multiple of it.
+typedef gfloat v4sf __attribute__((vector_size(16)));
+typedef gint32 v4si __attribute__((vector_size(16)));
+
+#define LANE_COUNT          4
+#define VECTOR_ALIGN        16
+
+// The level for silence.
+#define FLOOR_DBFS          -120.0f
+#define FLOOR_AMPLITUDE     1e-6f
+
+// The byte meter is linear up to 0x7f.
+#define BYTE_FULL_SCALE     127.0f
+
+typedef struct {
+    guint channels;
+    gdouble attack;
+    gdouble release;
+    gdouble peak_hold;
+    gdouble clip_level;
+
+    gsize vector_count;
+    gpointer block;
+    v4sf *scratch;
+    v4sf *levels;
+    v4sf *peaks;
+    v4sf *holds;
+    v4si *clips;
+
+    gboolean has_timestamp;
+    gint64 timestamp;
+} HitakiMeterProcessorPrivate;
+
+G_DEFINE_TYPE_WITH_PRIVATE(HitakiMeterProcessor, hitaki_meter_processor, G_TYPE_OBJECT)
+
+enum meter_processor_prop_type {
+    METER_PROCESSOR_PROP_CHANNELS = 1,
+    METER_PROCESSOR_PROP_ATTACK,
+    METER_PROCESSOR_PROP_RELEASE,
+    METER_PROCESSOR_PROP_PEAK_HOLD,
+    METER_PROCESSOR_PROP_CLIP_LEVEL,
+    METER_PROCESSOR_PROP_COUNT,
+};
+
+#define DEFAULT_ATTACK      10.0
+#define DEFAULT_RELEASE     300.0
+#define DEFAULT_PEAK_HOLD   1500.0
+#define DEFAULT_CLIP_LEVEL  -0.1
+
+#define MAXIMUM_CHANNELS    1024
+
+static void meter_processor_set_property(GObject *obj, guint id, const GValue *val,
+                                         GParamSpec *spec)
+{
+    HitakiMeterProcessor *self = HITAKI_METER_PROCESSOR(obj);
+    HitakiMeterProcessorPrivate *priv = hitaki_meter_processor_get_instance_private(self);
+
+    switch (id) {
+    case METER_PROCESSOR_PROP_CHANNELS:
+        priv->channels = g_value_get_uint(val);
+        break;
+    case METER_PROCESSOR_PROP_ATTACK:
+        priv->attack = g_value_get_double(val);
+        break;
+    case METER_PROCESSOR_PROP_RELEASE:
+        priv->release = g_value_get_double(val);
+        break;
+    case METER_PROCESSOR_PROP_PEAK_HOLD:
+        priv->peak_hold = g_value_get_double(val);
+        break;
+    case METER_PROCESSOR_PROP_CLIP_LEVEL:
+        priv->clip_level = g_value_get_double(val);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(obj, id, spec);
+        break;
+    }
+}
+
+static void meter_processor_get_property(GObject *obj, guint id, GValue *val, GParamSpec *spec)
+{
+    HitakiMeterProcessor *self = HITAKI_METER_PROCESSOR(obj);
+    HitakiMeterProcessorPrivate *priv = hitaki_meter_processor_get_instance_private(self);
+
+    switch (id) {
+    case METER_PROCESSOR_PROP_CHANNELS:
+        g_value_set_uint(val, priv->channels);
+        break;
+    case METER_PROCESSOR_PROP_ATTACK:
+        g_value_set_double(val, priv->attack);
+        break;
+    case METER_PROCESSOR_PROP_RELEASE:
+        g_value_set_double(val, priv->release);
+        break;
+    case METER_PROCESSOR_PROP_PEAK_HOLD:
+        g_value_set_double(val, priv->peak_hold);
+        break;
+    case METER_PROCESSOR_PROP_CLIP_LEVEL:
+        g_value_set_double(val, priv->clip_level);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(obj, id, spec);
+        break;
+    }
+}
+
+static void meter_processor_constructed(GObject *obj)
+{
+    HitakiMeterProcessor *self = HITAKI_METER_PROCESSOR(obj);
+    HitakiMeterProcessorPrivate *priv = hitaki_meter_processor_get_instance_private(self);
+    gsize size;
+    guint8 *ptr;
+
+    priv->vector_count = (priv->channels + LANE_COUNT - 1) / LANE_COUNT;
+    size = sizeof(v4sf) * priv->vector_count;
+
+    // One block for all of arrays, aligned for vector.
+    priv->block = g_malloc0(size * 5 + VECTOR_ALIGN - 1);
+    ptr = GSIZE_TO_POINTER((GPOINTER_TO_SIZE(priv->block) + VECTOR_ALIGN - 1) &
+                           ~((gsize)VECTOR_ALIGN - 1));
+    priv->scratch = (v4sf *)ptr;
+    priv->levels = (v4sf *)(ptr + size);
+    priv->peaks = (v4sf *)(ptr + size * 2);
+    priv->holds = (v4sf *)(ptr + size * 3);
+    priv->clips = (v4si *)(ptr + size * 4);
+
+    hitaki_meter_processor_reset(self);
+
+    G_OBJECT_CLASS(hitaki_meter_processor_parent_class)->constructed(obj);
+}
+
+static void meter_processor_finalize(GObject *obj)
+{
+    HitakiMeterProcessor *self = HITAKI_METER_PROCESSOR(obj);
+    HitakiMeterProcessorPrivate *priv = hitaki_meter_processor_get_instance_private(self);
+
+    g_free(priv->block);
+
+    G_OBJECT_CLASS(hitaki_meter_processor_parent_class)->finalize(obj);
+}
+
+static void hitaki_meter_processor_class_init(HitakiMeterProcessorClass *klass)
+{
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+
+    gobject_class->set_property = meter_processor_set_property;
+    gobject_class->get_property = meter_processor_get_property;
+    gobject_class->constructed = meter_processor_constructed;
+    gobject_class->finalize = meter_processor_finalize;
+
+    /**
+     * HitakiMeterProcessor:channels:
+     *
+     * The number of channels to process.
+     */
+    g_object_class_install_property(gobject_class, METER_PROCESSOR_PROP_CHANNELS,
+        g_param_spec_uint("channels", "channels",
+                          "The number of channels to process",
+                          1, MAXIMUM_CHANNELS, 1,
+                          G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY));
+
+    /**
+     * HitakiMeterProcessor:attack:
+     *
+     * The time constant in millisecond for the level to rise. Zero to rise immediately.
+     */
+    g_object_class_install_property(gobject_class, METER_PROCESSOR_PROP_ATTACK,
+        g_param_spec_double("attack", "attack",
+                            "The time constant in millisecond for the level to rise",
+                            0.0, G_MAXDOUBLE, DEFAULT_ATTACK,
+                            G_PARAM_READWRITE));
+
+    /**
+     * HitakiMeterProcessor:release:
+     *
+     * The time constant in millisecond for the level to fall. Zero to fall immediately.
+     */
+    g_object_class_install_property(gobject_class, METER_PROCESSOR_PROP_RELEASE,
+        g_param_spec_double("release", "release",
+                            "The time constant in millisecond for the level to fall",
+                            0.0, G_MAXDOUBLE, DEFAULT_RELEASE,
+                            G_PARAM_READWRITE));
+
+    /**
+     * HitakiMeterProcessor:peak-hold:
+     *
+     * The duration in millisecond to hold the peak. After the duration, the peak follows the
+     * level.
+     */
+    g_object_class_install_property(gobject_class, METER_PROCESSOR_PROP_PEAK_HOLD,
+        g_param_spec_double("peak-hold", "peak-hold",
+                            "The duration in millisecond to hold the peak",
+                            0.0, G_MAXDOUBLE, DEFAULT_PEAK_HOLD,
+                            G_PARAM_READWRITE));
+
+    /**
+     * HitakiMeterProcessor:clip-level:
+     *
+     * The level in dBFS at which the clip is latched till [method@MeterProcessor.reset_clips] is
+     * called.
+     */
+    g_object_class_install_property(gobject_class, METER_PROCESSOR_PROP_CLIP_LEVEL,
+        g_param_spec_double("clip-level", "clip-level",
+                            "The level in dBFS at which the clip is latched",
+                            FLOOR_DBFS, G_MAXDOUBLE, DEFAULT_CLIP_LEVEL,
+                            G_PARAM_READWRITE));
+}
+
+static void hitaki_meter_processor_init(HitakiMeterProcessor *self)
+{
+    HitakiMeterProcessorPrivate *priv = hitaki_meter_processor_get_instance_private(self);
+
+    priv->channels = 1;
+    priv->attack = DEFAULT_ATTACK;
+    priv->release = DEFAULT_RELEASE;
+    priv->peak_hold = DEFAULT_PEAK_HOLD;
+    priv->clip_level = DEFAULT_CLIP_LEVEL;
+}
+
+/**
+ * hitaki_meter_processor_new:
+ * @channels: The number of channels to process.
+ *
+ * Instantiate [class@MeterProcessor] object and return the instance.
+ *
+ * Returns: an instance of [class@MeterProcessor].
+ */
+HitakiMeterProcessor *hitaki_meter_processor_new(guint channels)
+{
+    return g_object_new(HITAKI_TYPE_METER_PROCESSOR, "channels", channels, NULL);
+}
+
+static inline v4sf broadcast(gfloat val)
+{
+    return (v4sf){ val, val, val, val };
+}
+
+static inline v4sf select_vector(v4si mask, v4sf a, v4sf b)
+{
+    return (v4sf)((mask & (v4si)a) | (~mask & (v4si)b));
+}
+
+// Approximate 20 * log10(x) by the exponent and the quadratic polynomial of mantissa in IEEE 754
+// single precision. The error is within 0.05 dB, enough for display.
+static inline v4sf fast_dbfs(v4sf x)
+{
+    const v4si exponent_mask = { 0x7f800000, 0x7f800000, 0x7f800000, 0x7f800000 };
+    const v4si mantissa_mask = { 0x007fffff, 0x007fffff, 0x007fffff, 0x007fffff };
+    const v4si one = { 0x3f800000, 0x3f800000, 0x3f800000, 0x3f800000 };
+    const v4si sign_mask = { 0x7fffffff, 0x7fffffff, 0x7fffffff, 0x7fffffff };
+    v4si bits;
+    v4sf exponent, mantissa, log2;
+
+    bits = (v4si)x & sign_mask;
+    x = (v4sf)bits;
+    x = select_vector(x < broadcast(FLOOR_AMPLITUDE), broadcast(FLOOR_AMPLITUDE), x);
+    bits = (v4si)x;
+
+    exponent = __builtin_convertvector(((bits & exponent_mask) >> 23) - 128, v4sf);
+    mantissa = (v4sf)((bits & mantissa_mask) | one);
+    log2 = exponent + (broadcast(-0.34484843f) * mantissa + broadcast(2.02466578f)) * mantissa -
+           broadcast(0.67487759f);
+
+    // 20 * log10(2) = 6.0206.
+    return log2 * broadcast(6.0206f);
+}
+
+// The ratio to move toward the target during the interval with the time constant.
+static gfloat compute_ratio(gdouble interval, gdouble time_constant, gboolean has_timestamp)
+{
+    if (!has_timestamp || time_constant <= 0.0)
+        return 1.0f;
+
+    return (gfloat)(1.0 - exp(-interval / time_constant));
+}
+
+static void process_scratch(HitakiMeterProcessorPrivate *priv, gint64 timestamp)
+{
+    gdouble interval = 0.0;
+    v4sf attack, release, hold, elapsed, clip_level, floor;
+    gsize i;
+
+    if (priv->has_timestamp && timestamp > priv->timestamp)
+        interval = (timestamp - priv->timestamp) / 1000.0;
+
+    attack = broadcast(compute_ratio(interval, priv->attack, priv->has_timestamp));
+    release = broadcast(compute_ratio(interval, priv->release, priv->has_timestamp));
+    hold = broadcast((gfloat)priv->peak_hold);
+    elapsed = broadcast((gfloat)interval);
+    clip_level = broadcast((gfloat)priv->clip_level);
+    floor = broadcast(0.0f);
+
+    for (i = 0; i < priv->vector_count; ++i) {
+        v4sf in = fast_dbfs(priv->scratch[i]);
+        v4sf level = priv->levels[i];
+        v4sf peak = priv->peaks[i];
+        v4sf remain = priv->holds[i];
+        v4si is_rising, is_new_peak;
+
+        // Ballistics.
+        is_rising = in > level;
+        level += (in - level) * select_vector(is_rising, attack, release);
+
+        // Peak hold, then the peak follows the level.
+        is_new_peak = in >= peak;
+        peak = select_vector(is_new_peak, in, peak);
+        remain = select_vector(is_new_peak, hold, remain - elapsed);
+        peak = select_vector(remain <= floor, level, peak);
+        peak = select_vector(level > peak, level, peak);
+
+        priv->levels[i] = level;
+        priv->peaks[i] = peak;
+        priv->holds[i] = remain;
+        priv->clips[i] |= in >= clip_level;
+    }
+
+    priv->has_timestamp = TRUE;
+    priv->timestamp = timestamp;
+}
+
+/**
+ * hitaki_meter_processor_process_float:
+ * @self: A [class@MeterProcessor].
+ * @meter: (array length=count): The linear meter information, 1.0 for full scale.
+ * @count: The number of elements in the array, up to [property@MeterProcessor:channels].
+ * @timestamp: The monotonic time in microsecond at which the meter information was sampled.
+ *
+ * Process the linear meter information in float, typically retrieved from MOTU command DSP
+ * models. The channels not in the array are processed as silence.
+ */
+void hitaki_meter_processor_process_float(HitakiMeterProcessor *self, const gfloat *meter,
+                                          gsize count, gint64 timestamp)
+{
+    HitakiMeterProcessorPrivate *priv;
+
+    g_return_if_fail(HITAKI_IS_METER_PROCESSOR(self));
+    g_return_if_fail(meter != NULL || count == 0);
+
+    priv = hitaki_meter_processor_get_instance_private(self);
+    g_return_if_fail(count <= priv->channels);
+
+    memset(priv->scratch, 0, sizeof(*priv->scratch) * priv->vector_count);
+    memcpy(priv->scratch, meter, sizeof(*meter) * count);
+
+    process_scratch(priv, timestamp);
+}
+
+/**
+ * hitaki_meter_processor_process_byte:
+ * @self: A [class@MeterProcessor].
+ * @meter: (array length=count): The linear meter information, 0x7f for full scale.
+ * @count: The number of elements in the array, up to [property@MeterProcessor:channels].
+ * @timestamp: The monotonic time in microsecond at which the meter information was sampled.
+ *
+ * Process the linear meter information in byte, typically retrieved from MOTU register DSP
+ * models. The channels not in the array are processed as silence.
+ */
+void hitaki_meter_processor_process_byte(HitakiMeterProcessor *self, const guint8 *meter,
+                                         gsize count, gint64 timestamp)
+{
+    HitakiMeterProcessorPrivate *priv;
+    gfloat *scratch;
+    gsize i;
+
+    g_return_if_fail(HITAKI_IS_METER_PROCESSOR(self));
+    g_return_if_fail(meter != NULL || count == 0);
+
+    priv = hitaki_meter_processor_get_instance_private(self);
+    g_return_if_fail(count <= priv->channels);
+
+    memset(priv->scratch, 0, sizeof(*priv->scratch) * priv->vector_count);
+    scratch = (gfloat *)priv->scratch;
+    for (i = 0; i < count; ++i)
+        scratch[i] = meter[i] / BYTE_FULL_SCALE;
+
+    process_scratch(priv, timestamp);
+}
+
+/**
+ * hitaki_meter_processor_get_levels:
+ * @self: A [class@MeterProcessor].
+ * @levels: (array length=count) (out) (transfer none): The levels in dBFS after ballistics.
+ * @count: (out): The number of channels.
+ *
+ * Get the levels of channels in dBFS after ballistics of attack and release.
+ */
+void hitaki_meter_processor_get_levels(HitakiMeterProcessor *self, const gfloat **levels,
+                                       gsize *count)
+{
+    HitakiMeterProcessorPrivate *priv;
+
+    g_return_if_fail(HITAKI_IS_METER_PROCESSOR(self));
+    g_return_if_fail(levels != NULL);
+    g_return_if_fail(count != NULL);
+
+    priv = hitaki_meter_processor_get_instance_private(self);
+
+    *levels = (const gfloat *)priv->levels;
+    *count = priv->channels;
+}
+
+/**
+ * hitaki_meter_processor_get_peaks:
+ * @self: A [class@MeterProcessor].
+ * @peaks: (array length=count) (out) (transfer none): The held peaks in dBFS.
+ * @count: (out): The number of channels.
+ *
+ * Get the peaks of channels in dBFS, held for the duration of
+ * [property@MeterProcessor:peak-hold].
+ */
+void hitaki_meter_processor_get_peaks(HitakiMeterProcessor *self, const gfloat **peaks,
+                                      gsize *count)
+{
+    HitakiMeterProcessorPrivate *priv;
+
+    g_return_if_fail(HITAKI_IS_METER_PROCESSOR(self));
+    g_return_if_fail(peaks != NULL);
+    g_return_if_fail(count != NULL);
+
+    priv = hitaki_meter_processor_get_instance_private(self);
+
+    *peaks = (const gfloat *)priv->peaks;
+    *count = priv->channels;
+}
+
+/**
+ * hitaki_meter_processor_get_clips:
+ * @self: A [class@MeterProcessor].
+ * @clips: (array length=count) (out) (transfer none): Non-zero for the channel latched by clip.
+ * @count: (out): The number of channels.
+ *
+ * Get the latches of clip for channels, set when the level reaches
+ * [property@MeterProcessor:clip-level].
+ */
+void hitaki_meter_processor_get_clips(HitakiMeterProcessor *self, const guint32 **clips,
+                                      gsize *count)
+{
+    HitakiMeterProcessorPrivate *priv;
+
+    g_return_if_fail(HITAKI_IS_METER_PROCESSOR(self));
+    g_return_if_fail(clips != NULL);
+    g_return_if_fail(count != NULL);
+
+    priv = hitaki_meter_processor_get_instance_private(self);
+
+    *clips = (const guint32 *)priv->clips;
+    *count = priv->channels;
+}
+
+/**
+ * hitaki_meter_processor_reset_clips:
+ * @self: A [class@MeterProcessor].
+ *
+ * Release the latches of clip for all channels.
+ */
+void hitaki_meter_processor_reset_clips(HitakiMeterProcessor *self)
+{
+    HitakiMeterProcessorPrivate *priv;
+
+    g_return_if_fail(HITAKI_IS_METER_PROCESSOR(self));
+
+    priv = hitaki_meter_processor_get_instance_private(self);
+
+    memset(priv->clips, 0, sizeof(*priv->clips) * priv->vector_count);
+}
+
+/**
+ * hitaki_meter_processor_reset:
+ * @self: A [class@MeterProcessor].
+ *
+ * Reset the levels and peaks to silence, and release the latches of clip. The next processing
+ * applies the meter information immediately.
+ */
+void hitaki_meter_processor_reset(HitakiMeterProcessor *self)
+{
+    HitakiMeterProcessorPrivate *priv;
+    gsize i;
+
+    g_return_if_fail(HITAKI_IS_METER_PROCESSOR(self));
+
+    priv = hitaki_meter_processor_get_instance_private(self);
+
+    for (i = 0; i < priv->vector_count; ++i) {
+        priv->levels[i] = broadcast(FLOOR_DBFS);
+        priv->peaks[i] = broadcast(FLOOR_DBFS);
+        priv->holds[i] = broadcast(0.0f);
+    }
+    memset(priv->clips, 0, sizeof(*priv->clips) * priv->vector_count);
+
+    priv->has_timestamp = FALSE;
+}
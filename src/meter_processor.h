@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#ifndef __HITAKI_METER_PROCESSOR_H__
+#define __HITAKI_METER_PROCESSOR_H__
+
+#include <hitaki.h>
+
+G_BEGIN_DECLS
+
+#define HITAKI_TYPE_METER_PROCESSOR     (hitaki_meter_processor_get_type())
+
+G_DECLARE_DERIVABLE_TYPE(HitakiMeterProcessor, hitaki_meter_processor, HITAKI, METER_PROCESSOR,
+                         GObject);
+
+struct _HitakiMeterProcessorClass {
+    GObjectClass parent_class;
+};
+
+HitakiMeterProcessor *hitaki_meter_processor_new(guint channels);
+
+void hitaki_meter_processor_process_float(HitakiMeterProcessor *self, const gfloat *meter,
+                                          gsize count, gint64 timestamp);
+
+void hitaki_meter_processor_process_byte(HitakiMeterProcessor *self, const guint8 *meter,
+                                         gsize count, gint64 timestamp);
+
+void hitaki_meter_processor_get_levels(HitakiMeterProcessor *self, const gfloat **levels,
+                                       gsize *count);
+
+void hitaki_meter_processor_get_peaks(HitakiMeterProcessor *self, const gfloat **peaks,
+                                      gsize *count);
+
+void hitaki_meter_processor_get_clips(HitakiMeterProcessor *self, const guint32 **clips,
+                                      gsize *count);
+
+void hitaki_meter_processor_reset_clips(HitakiMeterProcessor *self);
+
+void hitaki_meter_processor_reset(HitakiMeterProcessor *self);
+
+G_END_DECLS
+
+#endif
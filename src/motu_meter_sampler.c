@@ -0,0 +1,425 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#include "alsa_firewire_private.h"
+
+/**
+ * HitakiMotuMeterSampler:
+ * A GObject-derived object to sample meter information of MOTU FireWire series periodically.
+ *
+ * The [class@MotuMeterSampler] is an object class derived from [class@GObject.Object] to read
+ * meter information from [class@SndMotu] at the interval in the thread owned by this library.
+ * The sampled frame is stored with monotonic time stamp and sequence number into one of three
+ * buffers, and readers in any thread retrieve the latest frame without lock nor system call.
+ * The byte meter is sampled for register DSP models, and the float meter is sampled for command
+ * DSP models.
+ */
+
+enum meter_kind {
+    METER_KIND_BYTE = 0,
+    METER_KIND_FLOAT,
+};
+
+#define BYTE_METER_COUNT    SNDRV_FIREWIRE_MOTU_REGISTER_DSP_METER_COUNT
+#define FLOAT_METER_COUNT   SNDRV_FIREWIRE_MOTU_COMMAND_DSP_METER_COUNT
+
+struct meter_frame {
+    // Odd during update by the sampler.
+    guint seqlock;
+    guint sequence;
+    gint64 timestamp;
+    union {
+        guint8 bytes[BYTE_METER_COUNT];
+        gfloat floats[FLOAT_METER_COUNT];
+    };
+};
+
+// The writer fills the buffer next to the latest one, then publishes it. The reader copies the
+// latest buffer, and retries when the writer wraps around to the buffer during the copy.
+#define METER_FRAME_COUNT   3
+
+struct sampler_thread {
+    GThread *thread;
+    GMainContext *context;
+    GMainLoop *loop;
+    GSource *timer;
+
+    HitakiMotuMeterSampler *sampler;
+    HitakiSndMotu *unit;
+};
+
+typedef struct {
+    guint interval;
+
+    struct meter_frame frames[METER_FRAME_COUNT];
+    // The index of the latest frame, or negative when no frame is sampled yet.
+    gint latest;
+    guint sequence;
+    enum meter_kind kind;
+
+    struct sampler_thread *thread;
+} HitakiMotuMeterSamplerPrivate;
+
+G_DEFINE_TYPE_WITH_PRIVATE(HitakiMotuMeterSampler, hitaki_motu_meter_sampler, G_TYPE_OBJECT)
+
+enum motu_meter_sampler_prop_type {
+    MOTU_METER_SAMPLER_PROP_INTERVAL = 1,
+    MOTU_METER_SAMPLER_PROP_COUNT,
+};
+
+#define DEFAULT_INTERVAL    20
+
+static void motu_meter_sampler_set_property(GObject *obj, guint id, const GValue *val,
+                                            GParamSpec *spec)
+{
+    HitakiMotuMeterSampler *self = HITAKI_MOTU_METER_SAMPLER(obj);
+    HitakiMotuMeterSamplerPrivate *priv = hitaki_motu_meter_sampler_get_instance_private(self);
+
+    switch (id) {
+    case MOTU_METER_SAMPLER_PROP_INTERVAL:
+        priv->interval = g_value_get_uint(val);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(obj, id, spec);
+        break;
+    }
+}
+
+static void motu_meter_sampler_get_property(GObject *obj, guint id, GValue *val,
+                                            GParamSpec *spec)
+{
+    HitakiMotuMeterSampler *self = HITAKI_MOTU_METER_SAMPLER(obj);
+    HitakiMotuMeterSamplerPrivate *priv = hitaki_motu_meter_sampler_get_instance_private(self);
+
+    switch (id) {
+    case MOTU_METER_SAMPLER_PROP_INTERVAL:
+        g_value_set_uint(val, priv->interval);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(obj, id, spec);
+        break;
+    }
+}
+
+static void hitaki_motu_meter_sampler_class_init(HitakiMotuMeterSamplerClass *klass)
+{
+    GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+
+    gobject_class->set_property = motu_meter_sampler_set_property;
+    gobject_class->get_property = motu_meter_sampler_get_property;
+
+    /**
+     * HitakiMotuMeterSampler:interval:
+     *
+     * The interval to sample meter information in millisecond. The change is effective at
+     * next call of [method@MotuMeterSampler.start].
+     */
+    g_object_class_install_property(gobject_class, MOTU_METER_SAMPLER_PROP_INTERVAL,
+        g_param_spec_uint("interval", "interval",
+                          "The interval to sample meter information in millisecond",
+                          1, 1000, DEFAULT_INTERVAL,
+                          G_PARAM_READWRITE));
+}
+
+static void hitaki_motu_meter_sampler_init(HitakiMotuMeterSampler *self)
+{
+    HitakiMotuMeterSamplerPrivate *priv = hitaki_motu_meter_sampler_get_instance_private(self);
+
+    priv->interval = DEFAULT_INTERVAL;
+    priv->latest = -1;
+    priv->sequence = 0;
+    priv->thread = NULL;
+}
+
+/**
+ * hitaki_motu_meter_sampler_new:
+ *
+ * Instantiate [class@MotuMeterSampler] object and return the instance.
+ *
+ * Returns: an instance of [class@MotuMeterSampler].
+ */
+HitakiMotuMeterSampler *hitaki_motu_meter_sampler_new(void)
+{
+    return g_object_new(HITAKI_TYPE_MOTU_METER_SAMPLER, NULL);
+}
+
+static gboolean read_meter(HitakiSndMotu *unit, enum meter_kind kind, struct meter_frame *frame,
+                           GError **error)
+{
+    if (kind == METER_KIND_FLOAT) {
+        gfloat *meter = frame->floats;
+
+        return hitaki_motu_command_dsp_read_float_meter(HITAKI_MOTU_COMMAND_DSP(unit), &meter,
+                                                        error);
+    } else {
+        guint8 *meter = frame->bytes;
+
+        return hitaki_motu_register_dsp_read_byte_meter(HITAKI_MOTU_REGISTER_DSP(unit), &meter,
+                                                        error);
+    }
+}
+
+// Only one writer is allowed at the same time.
+static gboolean sample_frame(HitakiMotuMeterSamplerPrivate *priv, HitakiSndMotu *unit,
+                             GError **error)
+{
+    gint latest = g_atomic_int_get(&priv->latest);
+    gint index = (latest + 1) % METER_FRAME_COUNT;
+    struct meter_frame *frame = &priv->frames[index];
+    gboolean result;
+
+    g_atomic_int_inc(&frame->seqlock);
+    // The odd seqlock should be visible before any store to the frame.
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    result = read_meter(unit, priv->kind, frame, error);
+    if (result) {
+        frame->timestamp = g_get_monotonic_time();
+        frame->sequence = ++priv->sequence;
+    }
+
+    g_atomic_int_inc(&frame->seqlock);
+
+    if (result)
+        g_atomic_int_set(&priv->latest, index);
+
+    return result;
+}
+
+static gboolean sample_periodically(gpointer user_data)
+{
+    struct sampler_thread *th = (struct sampler_thread *)user_data;
+    HitakiMotuMeterSamplerPrivate *priv =
+        hitaki_motu_meter_sampler_get_instance_private(th->sampler);
+
+    // Keep the latest frame when the unit is not available temporarily.
+    (void)sample_frame(priv, th->unit, NULL);
+
+    return G_SOURCE_CONTINUE;
+}
+
+static gpointer run_thread(gpointer data)
+{
+    struct sampler_thread *th = (struct sampler_thread *)data;
+
+    g_main_context_push_thread_default(th->context);
+    g_main_loop_run(th->loop);
+    g_main_context_pop_thread_default(th->context);
+
+    return NULL;
+}
+
+static gboolean quit_loop(gpointer user_data)
+{
+    g_main_loop_quit((GMainLoop *)user_data);
+
+    return G_SOURCE_REMOVE;
+}
+
+static void release_thread(struct sampler_thread *th)
+{
+    g_source_destroy(th->timer);
+    g_source_unref(th->timer);
+
+    g_main_loop_unref(th->loop);
+    g_main_context_unref(th->context);
+
+    g_object_unref(th->unit);
+    g_object_unref(th->sampler);
+    g_free(th);
+}
+
+/**
+ * hitaki_motu_meter_sampler_start:
+ * @self: A [class@MotuMeterSampler].
+ * @unit: A [class@SndMotu].
+ * @error: A [struct@GLib.Error] with Hitaki.AlsaFirewireError domain.
+ *
+ * Start the thread owned by this library to sample meter information of the unit at the
+ * interval of [property@MotuMeterSampler:interval]. The first frame is sampled before return,
+ * to detect the float meter of command DSP models or the byte meter of register DSP models. The
+ * thread keeps the references to the object and the unit till [method@MotuMeterSampler.stop] is
+ * called.
+ *
+ * Returns: TRUE if the overall operation finished successfully, else FALSE.
+ */
+gboolean hitaki_motu_meter_sampler_start(HitakiMotuMeterSampler *self, HitakiSndMotu *unit,
+                                         GError **error)
+{
+    HitakiMotuMeterSamplerPrivate *priv;
+    struct sampler_thread *th;
+
+    g_return_val_if_fail(HITAKI_IS_MOTU_METER_SAMPLER(self), FALSE);
+    g_return_val_if_fail(HITAKI_IS_SND_MOTU(unit), FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    priv = hitaki_motu_meter_sampler_get_instance_private(self);
+    g_return_val_if_fail(priv->thread == NULL, FALSE);
+
+    g_atomic_int_set(&priv->latest, -1);
+
+    // The command DSP models reject the request for byte meter, and vice versa.
+    priv->kind = METER_KIND_FLOAT;
+    if (!sample_frame(priv, unit, NULL)) {
+        priv->kind = METER_KIND_BYTE;
+        if (!sample_frame(priv, unit, error))
+            return FALSE;
+    }
+
+    th = g_new0(struct sampler_thread, 1);
+    th->sampler = g_object_ref(self);
+    th->unit = g_object_ref(unit);
+
+    th->context = g_main_context_new();
+    th->loop = g_main_loop_new(th->context, FALSE);
+
+    th->timer = g_timeout_source_new(priv->interval);
+    g_source_set_callback(th->timer, sample_periodically, th, NULL);
+    g_source_attach(th->timer, th->context);
+
+    th->thread = g_thread_try_new("hitaki-meter", run_thread, th, error);
+    if (th->thread == NULL) {
+        release_thread(th);
+        return FALSE;
+    }
+
+    priv->thread = th;
+
+    return TRUE;
+}
+
+/**
+ * hitaki_motu_meter_sampler_stop:
+ * @self: A [class@MotuMeterSampler].
+ *
+ * Stop the thread started by [method@MotuMeterSampler.start]. The latest frame is still
+ * available. Nothing happens when the thread is not running.
+ */
+void hitaki_motu_meter_sampler_stop(HitakiMotuMeterSampler *self)
+{
+    HitakiMotuMeterSamplerPrivate *priv;
+    struct sampler_thread *th;
+    GSource *source;
+
+    g_return_if_fail(HITAKI_IS_MOTU_METER_SAMPLER(self));
+
+    priv = hitaki_motu_meter_sampler_get_instance_private(self);
+
+    th = priv->thread;
+    if (th == NULL)
+        return;
+    priv->thread = NULL;
+
+    // The request to quit is queued so that it is not lost even if the loop does not run yet.
+    source = g_idle_source_new();
+    g_source_set_callback(source, quit_loop, th->loop, NULL);
+    g_source_attach(source, th->context);
+    g_source_unref(source);
+
+    g_thread_join(th->thread);
+
+    release_thread(th);
+}
+
+static gboolean read_frame(HitakiMotuMeterSamplerPrivate *priv, enum meter_kind kind,
+                           void *meter, gsize size, gint64 *timestamp, guint *sequence,
+                           GError **error)
+{
+    guint seqlock;
+    gint index;
+
+    index = g_atomic_int_get(&priv->latest);
+    if (index < 0) {
+        generate_alsa_firewire_error(error, HITAKI_ALSA_FIREWIRE_ERROR_IS_NOT_OPENED);
+        return FALSE;
+    }
+
+    if (priv->kind != kind) {
+        generate_alsa_firewire_error(error, HITAKI_ALSA_FIREWIRE_ERROR_WRONG_CLASS);
+        return FALSE;
+    }
+
+    while (TRUE) {
+        const struct meter_frame *frame;
+
+        index = g_atomic_int_get(&priv->latest);
+        frame = &priv->frames[index];
+
+        seqlock = g_atomic_int_get(&frame->seqlock);
+        if (seqlock & 1)
+            continue;
+
+        memcpy(meter, kind == METER_KIND_FLOAT ? (const void *)frame->floats :
+                                                 (const void *)frame->bytes, size);
+        *timestamp = frame->timestamp;
+        *sequence = frame->sequence;
+
+        // The plain loads above should not be reordered after the load of seqlock below.
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (seqlock == (guint)g_atomic_int_get(&frame->seqlock))
+            break;
+    }
+
+    return TRUE;
+}
+
+/**
+ * hitaki_motu_meter_sampler_read_byte_meter:
+ * @self: A [class@MotuMeterSampler].
+ * @meter: (array fixed-size=48) (inout): The data of meter. Index 0 to 23 for inputs and index
+ *         24 to 47 for outputs.
+ * @timestamp: (out): The monotonic time in microsecond at which the frame was sampled.
+ * @sequence: (out): The sequence number of frame, incremented for each sample.
+ * @error: A [struct@GLib.Error] with Hitaki.AlsaFirewireError domain.
+ *
+ * Copy the latest frame of byte meter sampled from register DSP models, without lock nor system
+ * call.
+ *
+ * Returns: TRUE if the overall operation finished successfully, else FALSE.
+ */
+gboolean hitaki_motu_meter_sampler_read_byte_meter(HitakiMotuMeterSampler *self,
+                                                   guint8 *const meter[48], gint64 *timestamp,
+                                                   guint *sequence, GError **error)
+{
+    HitakiMotuMeterSamplerPrivate *priv;
+
+    g_return_val_if_fail(HITAKI_IS_MOTU_METER_SAMPLER(self), FALSE);
+    g_return_val_if_fail(meter != NULL && *meter != NULL, FALSE);
+    g_return_val_if_fail(timestamp != NULL, FALSE);
+    g_return_val_if_fail(sequence != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    priv = hitaki_motu_meter_sampler_get_instance_private(self);
+
+    return read_frame(priv, METER_KIND_BYTE, *meter, sizeof(guint8) * BYTE_METER_COUNT,
+                      timestamp, sequence, error);
+}
+
+/**
+ * hitaki_motu_meter_sampler_read_float_meter:
+ * @self: A [class@MotuMeterSampler].
+ * @meter: (array fixed-size=400) (inout): The data of meter.
+ * @timestamp: (out): The monotonic time in microsecond at which the frame was sampled.
+ * @sequence: (out): The sequence number of frame, incremented for each sample.
+ * @error: A [struct@GLib.Error] with Hitaki.AlsaFirewireError domain.
+ *
+ * Copy the latest frame of float meter sampled from command DSP models, without lock nor system
+ * call.
+ *
+ * Returns: TRUE if the overall operation finished successfully, else FALSE.
+ */
+gboolean hitaki_motu_meter_sampler_read_float_meter(HitakiMotuMeterSampler *self,
+                                                    gfloat *const meter[400], gint64 *timestamp,
+                                                    guint *sequence, GError **error)
+{
+    HitakiMotuMeterSamplerPrivate *priv;
+
+    g_return_val_if_fail(HITAKI_IS_MOTU_METER_SAMPLER(self), FALSE);
+    g_return_val_if_fail(meter != NULL && *meter != NULL, FALSE);
+    g_return_val_if_fail(timestamp != NULL, FALSE);
+    g_return_val_if_fail(sequence != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    priv = hitaki_motu_meter_sampler_get_instance_private(self);
+
+    return read_frame(priv, METER_KIND_FLOAT, *meter, sizeof(gfloat) * FLOAT_METER_COUNT,
+                      timestamp, sequence, error);
+}
@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#ifndef __HITAKI_MOTU_METER_SAMPLER_H__
+#define __HITAKI_MOTU_METER_SAMPLER_H__
+
+#include <hitaki.h>
+
+G_BEGIN_DECLS
+
+#define HITAKI_TYPE_MOTU_METER_SAMPLER  (hitaki_motu_meter_sampler_get_type())
+
+G_DECLARE_DERIVABLE_TYPE(HitakiMotuMeterSampler, hitaki_motu_meter_sampler, HITAKI,
+                         MOTU_METER_SAMPLER, GObject);
+
+struct _HitakiMotuMeterSamplerClass {
+    GObjectClass parent_class;
+};
+
+HitakiMotuMeterSampler *hitaki_motu_meter_sampler_new(void);
+
+gboolean hitaki_motu_meter_sampler_start(HitakiMotuMeterSampler *self, HitakiSndMotu *unit,
+                                         GError **error);
+
+void hitaki_motu_meter_sampler_stop(HitakiMotuMeterSampler *self);
+
+gboolean hitaki_motu_meter_sampler_read_byte_meter(HitakiMotuMeterSampler *self,
+                                                   guint8 *const meter[48], gint64 *timestamp,
+                                                   guint *sequence, GError **error);
+
+gboolean hitaki_motu_meter_sampler_read_float_meter(HitakiMotuMeterSampler *self,
+                                                    gfloat *const meter[400], gint64 *timestamp,
+                                                    guint *sequence, GError **error);
+
+G_END_DECLS
+
+#endif
@@ -1,5 +1,8 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
-#include "motu_register_dsp.h"
+#include "motu_register_dsp_private.h"
+#include "trace_private.h"
+
+#include <sound/firewire.h>
 
 /**
  * HitakiMotuRegisterDsp:
@@ -12,6 +15,8 @@
  */
 G_DEFINE_INTERFACE(HitakiMotuRegisterDsp, hitaki_motu_register_dsp, G_TYPE_OBJECT)
 
+static guint motu_register_dsp_sigs[MOTU_REGISTER_DSP_SIG_COUNT] = { 0 };
+
 static void hitaki_motu_register_dsp_default_init(HitakiMotuRegisterDspInterface *iface)
 {
     /**
@@ -27,14 +32,148 @@ static void hitaki_motu_register_dsp_default_init(HitakiMotuRegisterDspInterface
      * value. The meaning of identifier 0, 1 and value is decided depending on the type. For
      * detail, see `sound/firewire/motu/motu-register-dsp-message-parser.c` in Linux kernel.
      */
-    g_signal_new("changed",
-            G_TYPE_FROM_INTERFACE(iface),
-            G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
-            G_STRUCT_OFFSET(HitakiMotuRegisterDspInterface, changed),
-            NULL, NULL,
-            hitaki_sigs_marshal_VOID__POINTER_UINT,
-            G_TYPE_NONE,
-            2, G_TYPE_POINTER, G_TYPE_UINT);
+    motu_register_dsp_sigs[MOTU_REGISTER_DSP_SIG_CHANGED] =
+        g_signal_new("changed",
+                G_TYPE_FROM_INTERFACE(iface),
+                G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
+                G_STRUCT_OFFSET(HitakiMotuRegisterDspInterface, changed),
+                NULL, NULL,
+                hitaki_sigs_marshal_VOID__POINTER_UINT,
+                G_TYPE_NONE,
+                2, G_TYPE_POINTER, G_TYPE_UINT);
+
+    /**
+     * HitakiMotuRegisterDsp::parameter-changed:
+     * @self: A [iface@MotuRegisterDsp]
+     * @param_type: One of [enum@MotuRegisterDspParameterType] for the type of parameter.
+     * @index0: The numeric index of mixer for the parameters of mixer, or the numeric index of
+     *          input for the parameters of input. Zero for the others.
+     * @index1: The numeric index of source for the parameters of source to mixer. Zero for the
+     *          others.
+     * @value: The new value of parameter.
+     *
+     * Emitted for each event of change decoded from the encoded data delivered by
+     * [signal@MotuRegisterDsp::changed] signal. The events of unknown type are not emitted.
+     */
+    motu_register_dsp_sigs[MOTU_REGISTER_DSP_SIG_PARAMETER_CHANGED] =
+        g_signal_new("parameter-changed",
+                G_TYPE_FROM_INTERFACE(iface),
+                G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
+                G_STRUCT_OFFSET(HitakiMotuRegisterDspInterface, parameter_changed),
+                NULL, NULL,
+                hitaki_sigs_marshal_VOID__ENUM_UINT_UINT_UINT,
+                G_TYPE_NONE,
+                4, HITAKI_TYPE_MOTU_REGISTER_DSP_PARAMETER_TYPE, G_TYPE_UINT, G_TYPE_UINT,
+                G_TYPE_UINT);
+    g_signal_set_va_marshaller(motu_register_dsp_sigs[MOTU_REGISTER_DSP_SIG_PARAMETER_CHANGED],
+                               G_TYPE_FROM_INTERFACE(iface),
+                               hitaki_sigs_marshal_VOID__ENUM_UINT_UINT_UINTv);
+}
+
+// Any class closure or signal handler to receive the signal.
+gboolean motu_register_dsp_has_handler(HitakiMotuRegisterDsp *self,
+                                       enum motu_register_dsp_sig_type type)
+{
+    HitakiMotuRegisterDspInterface *iface = HITAKI_MOTU_REGISTER_DSP_GET_IFACE(self);
+    gboolean has_class_closure;
+
+    switch (type) {
+    case MOTU_REGISTER_DSP_SIG_CHANGED:
+        has_class_closure = iface->changed != NULL;
+        break;
+    case MOTU_REGISTER_DSP_SIG_PARAMETER_CHANGED:
+        has_class_closure = iface->parameter_changed != NULL;
+        break;
+    default:
+        return FALSE;
+    }
+
+    return has_class_closure ||
+           g_signal_has_handler_pending(self, motu_register_dsp_sigs[type], 0, FALSE);
+}
+
+void motu_register_dsp_emit_changed(HitakiMotuRegisterDsp *self, const guint32 *events,
+                                    guint length)
+{
+    TRACE_PROBE2(signal_emit_entry, self, "changed");
+    g_signal_emit(self, motu_register_dsp_sigs[MOTU_REGISTER_DSP_SIG_CHANGED], 0, events, length);
+    TRACE_PROBE2(signal_emit_exit, self, "changed");
+}
+
+// Decode the event for change of register DSP. For detail, see
+// `sound/firewire/motu/motu-register-dsp-message-parser.c` in Linux kernel.
+gboolean motu_register_dsp_decode_event(guint32 event,
+                                        HitakiMotuRegisterDspParameterType *param_type,
+                                        guint *index0, guint *index1, guint8 *value)
+{
+    HitakiMotuRegisterDspParameterType type = (event & 0xff000000) >> 24;
+    guint id0 = (event & 0x00ff0000) >> 16;
+    guint id1 = (event & 0x0000ff00) >> 8;
+
+    switch (type) {
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_GAIN:
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_PAN:
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_FLAG:
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_PAIRED_BALANCE:
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_PAIRED_WIDTH:
+        if (id0 >= SNDRV_FIREWIRE_MOTU_REGISTER_DSP_MIXER_COUNT ||
+            id1 >= SNDRV_FIREWIRE_MOTU_REGISTER_DSP_MIXER_SRC_COUNT)
+            return FALSE;
+        break;
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_OUTPUT_PAIRED_VOLUME:
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_OUTPUT_PAIRED_FLAG:
+        if (id0 >= SNDRV_FIREWIRE_MOTU_REGISTER_DSP_MIXER_COUNT)
+            return FALSE;
+        id1 = 0;
+        break;
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_INPUT_GAIN_AND_INVERT:
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_INPUT_FLAG:
+        if (id0 >= SNDRV_FIREWIRE_MOTU_REGISTER_DSP_ALIGNED_INPUT_COUNT)
+            return FALSE;
+        id1 = 0;
+        break;
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MAIN_OUTPUT_PAIRED_VOLUME:
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_HP_OUTPUT_PAIRED_VOLUME:
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_HP_OUTPUT_PAIRED_ASSIGNMENT:
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_LINE_INPUT_BOOST:
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_LINE_INPUT_NOMINAL_LEVEL:
+        id0 = 0;
+        id1 = 0;
+        break;
+    default:
+        return FALSE;
+    }
+
+    *param_type = type;
+    *index0 = id0;
+    *index1 = id1;
+    *value = event & 0x000000ff;
+
+    return TRUE;
+}
+
+// Return the number of emitted signals.
+guint motu_register_dsp_emit_parameter_changed(HitakiMotuRegisterDsp *self, const guint32 *events,
+                                               guint length)
+{
+    guint emitted = 0;
+    int i;
+
+    for (i = 0; i < length; ++i) {
+        HitakiMotuRegisterDspParameterType param_type;
+        guint index0, index1;
+        guint8 value;
+
+        if (motu_register_dsp_decode_event(events[i], &param_type, &index0, &index1, &value)) {
+            TRACE_PROBE2(signal_emit_entry, self, "parameter-changed");
+            g_signal_emit(self, motu_register_dsp_sigs[MOTU_REGISTER_DSP_SIG_PARAMETER_CHANGED],
+                          0, param_type, index0, index1, value);
+            TRACE_PROBE2(signal_emit_exit, self, "parameter-changed");
+            ++emitted;
+        }
+    }
+
+    return emitted;
 }
 
 /**
@@ -52,6 +52,20 @@ struct _HitakiMotuRegisterDspInterface {
      * Class closure for the [signal@MotuRegisterDsp::changed] signal.
      */
     void (*changed)(HitakiMotuRegisterDsp *self, const guint32 *events, guint length);
+
+    /**
+     * HitakiMotuRegisterDspInterface::parameter_changed:
+     * @self: A [iface@MotuRegisterDsp]
+     * @param_type: One of [enum@MotuRegisterDspParameterType] for the type of parameter.
+     * @index0: The numeric index of mixer or input.
+     * @index1: The numeric index of source to mixer.
+     * @value: The new value of parameter.
+     *
+     * Class closure for the [signal@MotuRegisterDsp::parameter-changed] signal.
+     */
+    void (*parameter_changed)(HitakiMotuRegisterDsp *self,
+                              HitakiMotuRegisterDspParameterType param_type, guint index0,
+                              guint index1, guint value);
 };
 
 gboolean hitaki_motu_register_dsp_read_parameter(HitakiMotuRegisterDsp *self,
@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#ifndef __HITAKI_MOTU_REGISTER_DSP_PRIVATE_H__
+#define __HITAKI_MOTU_REGISTER_DSP_PRIVATE_H__
+
+#include "hitaki.h"
+
+enum motu_register_dsp_sig_type {
+    MOTU_REGISTER_DSP_SIG_CHANGED = 0,
+    MOTU_REGISTER_DSP_SIG_PARAMETER_CHANGED,
+    MOTU_REGISTER_DSP_SIG_COUNT,
+};
+
+gboolean motu_register_dsp_has_handler(HitakiMotuRegisterDsp *self,
+                                       enum motu_register_dsp_sig_type type);
+
+void motu_register_dsp_emit_changed(HitakiMotuRegisterDsp *self, const guint32 *events,
+                                    guint length);
+
+guint motu_register_dsp_emit_parameter_changed(HitakiMotuRegisterDsp *self, const guint32 *events,
+                                               guint length);
+
+gboolean motu_register_dsp_decode_event(guint32 event,
+                                        HitakiMotuRegisterDspParameterType *param_type,
+                                        guint *index0, guint *index1, guint8 *value);
+
+#endif
@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
-#include "quadlet_notification.h"
+#include "quadlet_notification_private.h"
+#include "trace_private.h"
 
 /**
  * HitakiQuadletNotification:
@@ -11,6 +12,12 @@
  */
 G_DEFINE_INTERFACE(HitakiQuadletNotification, hitaki_quadlet_notification, G_TYPE_OBJECT)
 
+enum quadlet_notification_sig_type {
+    QUADLET_NOTIFICATION_SIG_NOTIFIED = 0,
+    QUADLET_NOTIFICATION_SIG_COUNT,
+};
+static guint quadlet_notification_sigs[QUADLET_NOTIFICATION_SIG_COUNT] = { 0 };
+
 static void hitaki_quadlet_notification_default_init(HitakiQuadletNotificationInterface *iface)
 {
     /**
@@ -20,11 +27,28 @@ static void hitaki_quadlet_notification_default_init(HitakiQuadletNotificationIn
      *
      * Emitted when the target unit transfers notification.
      */
-    g_signal_new("notified",
-                 G_TYPE_FROM_INTERFACE(iface),
-                 G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
-                 G_STRUCT_OFFSET(HitakiQuadletNotificationInterface, notified),
-                 NULL, NULL,
-                 g_cclosure_marshal_VOID__UINT,
-                 G_TYPE_NONE, 1, G_TYPE_UINT);
+    quadlet_notification_sigs[QUADLET_NOTIFICATION_SIG_NOTIFIED] =
+        g_signal_new("notified",
+                     G_TYPE_FROM_INTERFACE(iface),
+                     G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
+                     G_STRUCT_OFFSET(HitakiQuadletNotificationInterface, notified),
+                     NULL, NULL,
+                     g_cclosure_marshal_VOID__UINT,
+                     G_TYPE_NONE, 1, G_TYPE_UINT);
+}
+
+// Any class closure or signal handler to receive the signal.
+gboolean quadlet_notification_has_handler(HitakiQuadletNotification *self)
+{
+    return HITAKI_QUADLET_NOTIFICATION_GET_IFACE(self)->notified != NULL ||
+           g_signal_has_handler_pending(self,
+                                        quadlet_notification_sigs[QUADLET_NOTIFICATION_SIG_NOTIFIED],
+                                        0, FALSE);
+}
+
+void quadlet_notification_emit_notified(HitakiQuadletNotification *self, guint32 message)
+{
+    TRACE_PROBE2(signal_emit_entry, self, "notified");
+    g_signal_emit(self, quadlet_notification_sigs[QUADLET_NOTIFICATION_SIG_NOTIFIED], 0, message);
+    TRACE_PROBE2(signal_emit_exit, self, "notified");
 }
@@ -0,0 +1,11 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#ifndef __HITAKI_QUADLET_NOTIFICATION_PRIVATE_H__
+#define __HITAKI_QUADLET_NOTIFICATION_PRIVATE_H__
+
+#include "hitaki.h"
+
+gboolean quadlet_notification_has_handler(HitakiQuadletNotification *self);
+
+void quadlet_notification_emit_notified(HitakiQuadletNotification *self, guint32 message);
+
+#endif
@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 #include "alsa_firewire_private.h"
+#include "quadlet_notification_private.h"
 
 /**
  * HitakiSndDice:
@@ -13,6 +14,8 @@ typedef struct {
     struct alsa_firewire_state state;
 } HitakiSndDicePrivate;
 
+static void handle_event(HitakiAlsaFirewire *inst, const union snd_firewire_event *event,
+                         size_t length);
 static void alsa_firewire_iface_init(HitakiAlsaFirewireInterface *iface);
 static void quadlet_notification_iface_init(HitakiQuadletNotificationInterface *iface);
 
@@ -63,7 +66,7 @@ static void hitaki_snd_dice_init(HitakiSndDice *self)
 {
     HitakiSndDicePrivate *priv = hitaki_snd_dice_get_instance_private(self);
 
-    alsa_firewire_state_init(&priv->state);
+    alsa_firewire_state_init(&priv->state, HITAKI_ALSA_FIREWIRE(self), handle_event);
 }
 
 static gboolean snd_dice_open(HitakiAlsaFirewire *inst, const gchar *path, gint open_flag,
@@ -121,8 +124,18 @@ static gboolean snd_dice_unlock(HitakiAlsaFirewire *inst, GError **error)
 static void handle_event(HitakiAlsaFirewire *inst, const union snd_firewire_event *event,
                          size_t length)
 {
-    if (event->common.type == SNDRV_FIREWIRE_EVENT_DICE_NOTIFICATION)
-        g_signal_emit_by_name(inst, "notified", event->dice_notification.notification);
+    if (event->common.type == SNDRV_FIREWIRE_EVENT_DICE_NOTIFICATION) {
+        HitakiQuadletNotification *self = HITAKI_QUADLET_NOTIFICATION(inst);
+        HitakiSndDicePrivate *priv = hitaki_snd_dice_get_instance_private(HITAKI_SND_DICE(inst));
+        guint32 message = event->dice_notification.notification;
+
+        alsa_firewire_state_push_event(&priv->state, HITAKI_UNIT_EVENT_TYPE_NOTIFIED, &message, 1);
+
+        if (quadlet_notification_has_handler(self)) {
+            quadlet_notification_emit_notified(self, message);
+            alsa_firewire_state_count_signals(&priv->state, 1);
+        }
+    }
 }
 
 static gboolean snd_dice_create_source(HitakiAlsaFirewire *inst, GSource **source, GError **error)
@@ -136,7 +149,7 @@ static gboolean snd_dice_create_source(HitakiAlsaFirewire *inst, GSource **sourc
     self = HITAKI_SND_DICE(inst);
     priv = hitaki_snd_dice_get_instance_private(self);
 
-    return alsa_firewire_state_create_source(&priv->state, inst, handle_event, source, error);
+    return alsa_firewire_state_create_source(&priv->state, source, error);
 }
 
 static void alsa_firewire_iface_init(HitakiAlsaFirewireInterface *iface)
@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 #include "alsa_firewire_private.h"
+#include "quadlet_notification_private.h"
 
 /**
  * HitakiSndDigi00x:
@@ -13,6 +14,8 @@ typedef struct {
     struct alsa_firewire_state state;
 } HitakiSndDigi00xPrivate;
 
+static void handle_event(HitakiAlsaFirewire *inst, const union snd_firewire_event *event,
+                         size_t length);
 static void alsa_firewire_iface_init(HitakiAlsaFirewireInterface *iface);
 static void quadlet_notification_iface_init(HitakiQuadletNotificationInterface *iface);
 
@@ -63,7 +66,7 @@ static void hitaki_snd_digi00x_init(HitakiSndDigi00x *self)
 {
     HitakiSndDigi00xPrivate *priv = hitaki_snd_digi00x_get_instance_private(self);
 
-    alsa_firewire_state_init(&priv->state);
+    alsa_firewire_state_init(&priv->state, HITAKI_ALSA_FIREWIRE(self), handle_event);
 }
 
 static gboolean snd_digi00x_open(HitakiAlsaFirewire *inst, const gchar *path, gint open_flag,
@@ -121,8 +124,18 @@ static gboolean snd_digi00x_unlock(HitakiAlsaFirewire *inst, GError **error)
 static void handle_event(HitakiAlsaFirewire *inst, const union snd_firewire_event *event,
                          size_t length)
 {
-    if (event->common.type == SNDRV_FIREWIRE_EVENT_DIGI00X_MESSAGE)
-        g_signal_emit_by_name(inst, "notified", event->digi00x_message.message);
+    if (event->common.type == SNDRV_FIREWIRE_EVENT_DIGI00X_MESSAGE) {
+        HitakiQuadletNotification *self = HITAKI_QUADLET_NOTIFICATION(inst);
+        HitakiSndDigi00xPrivate *priv = hitaki_snd_digi00x_get_instance_private(HITAKI_SND_DIGI00X(inst));
+        guint32 message = event->digi00x_message.message;
+
+        alsa_firewire_state_push_event(&priv->state, HITAKI_UNIT_EVENT_TYPE_NOTIFIED, &message, 1);
+
+        if (quadlet_notification_has_handler(self)) {
+            quadlet_notification_emit_notified(self, message);
+            alsa_firewire_state_count_signals(&priv->state, 1);
+        }
+    }
 }
 
 static gboolean snd_digi00x_create_source(HitakiAlsaFirewire *inst, GSource **source, GError **error)
@@ -136,7 +149,7 @@ static gboolean snd_digi00x_create_source(HitakiAlsaFirewire *inst, GSource **so
     self = HITAKI_SND_DIGI00X(inst);
     priv = hitaki_snd_digi00x_get_instance_private(self);
 
-    return alsa_firewire_state_create_source(&priv->state, inst, handle_event, source, error);
+    return alsa_firewire_state_create_source(&priv->state, source, error);
 }
 
 static void alsa_firewire_iface_init(HitakiAlsaFirewireInterface *iface)
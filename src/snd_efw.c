@@ -17,9 +17,10 @@ typedef struct {
     struct alsa_firewire_state state;
 
     guint32 seqnum;
-    GMutex lock;
 } HitakiSndEfwPrivate;
 
+static void handle_event(HitakiAlsaFirewire *inst, const union snd_firewire_event *event,
+                         size_t length);
 static void alsa_firewire_iface_init(HitakiAlsaFirewireInterface *iface);
 static void efw_protocol_iface_init(HitakiEfwProtocolInterface *iface);
 
@@ -69,10 +70,9 @@ static void hitaki_snd_efw_init(HitakiSndEfw *self)
 {
     HitakiSndEfwPrivate *priv = hitaki_snd_efw_get_instance_private(self);
 
-    alsa_firewire_state_init(&priv->state);
+    alsa_firewire_state_init(&priv->state, HITAKI_ALSA_FIREWIRE(self), handle_event);
 
-    priv->seqnum = 0;
-    g_mutex_init(&priv->lock);
+    g_atomic_int_set(&priv->seqnum, 0);
 }
 
 static gboolean snd_efw_open(HitakiAlsaFirewire *inst, const gchar *path, gint open_flag,
@@ -128,15 +128,44 @@ static gboolean snd_efw_unlock(HitakiAlsaFirewire *inst, GError **error)
     return alsa_firewire_state_unlock(&priv->state, error);
 }
 
+// Push the header of each response frame. The parameters are not included.
+static void push_response_events(const struct alsa_firewire_state *state, const guint8 *buf,
+                                 size_t length)
+{
+    while (length >= sizeof(struct snd_efw_transaction)) {
+        const struct snd_efw_transaction *frame = (const struct snd_efw_transaction *)buf;
+        size_t frame_length = GUINT32_FROM_BE(frame->length) * sizeof(__be32);
+        guint32 values[6];
+
+        if (frame_length < sizeof(*frame) || frame_length > length)
+            break;
+
+        values[0] = GUINT32_FROM_BE(frame->version);
+        values[1] = GUINT32_FROM_BE(frame->seqnum);
+        values[2] = GUINT32_FROM_BE(frame->category);
+        values[3] = GUINT32_FROM_BE(frame->command);
+        values[4] = GUINT32_FROM_BE(frame->status);
+        values[5] = (frame_length - sizeof(*frame)) / sizeof(__be32);
+        alsa_firewire_state_push_event(state, HITAKI_UNIT_EVENT_TYPE_EFW_RESPONDED, values,
+                                       G_N_ELEMENTS(values));
+
+        buf += frame_length;
+        length -= frame_length;
+    }
+}
+
 static void handle_event(HitakiAlsaFirewire *inst, const union snd_firewire_event *event,
                          size_t length)
 {
     HitakiSndEfw *self;
+    HitakiSndEfwPrivate *priv;
 
     const __be32 *buf;
+    guint emitted;
 
     g_return_if_fail(HITAKI_IS_SND_EFW(inst));
     self = HITAKI_SND_EFW(inst);
+    priv = hitaki_snd_efw_get_instance_private(self);
 
     length -= sizeof(event->efw_response.type);
     buf = event->efw_response.response;
@@ -146,7 +175,12 @@ static void handle_event(HitakiAlsaFirewire *inst, const union snd_firewire_even
     // workaround.
     length += 4;
 
-    hitaki_efw_protocol_receive_response(HITAKI_EFW_PROTOCOL(self), (const guint8 *)buf, length);
+    if (priv->state.event_ring != NULL)
+        push_response_events(&priv->state, (const guint8 *)buf, length);
+
+    emitted = efw_protocol_receive_response(HITAKI_EFW_PROTOCOL(self), (const guint8 *)buf,
+                                            length);
+    alsa_firewire_state_count_signals(&priv->state, emitted);
 }
 
 static gboolean snd_efw_create_source(HitakiAlsaFirewire *inst, GSource **source, GError **error)
@@ -160,7 +194,7 @@ static gboolean snd_efw_create_source(HitakiAlsaFirewire *inst, GSource **source
     self = HITAKI_SND_EFW(inst);
     priv = hitaki_snd_efw_get_instance_private(self);
 
-    return alsa_firewire_state_create_source(&priv->state, inst, handle_event, source, error);
+    return alsa_firewire_state_create_source(&priv->state, source, error);
 }
 
 static void alsa_firewire_iface_init(HitakiAlsaFirewireInterface *iface)
@@ -185,7 +219,7 @@ static gboolean snd_efw_transmit_request(HitakiEfwProtocol *inst, const guint8 *
     self = HITAKI_SND_EFW(inst);
     priv = hitaki_snd_efw_get_instance_private(self);
 
-    len = write(priv->state.fd, (const void *)buffer, length);
+    len = alsa_firewire_state_write(&priv->state, (const void *)buffer, length);
     if (len != length) {
         if (len < 0)
             generate_alsa_firewire_syscall_error(error, errno, "write(%ld)", length);
@@ -197,6 +231,32 @@ static gboolean snd_efw_transmit_request(HitakiEfwProtocol *inst, const guint8 *
     return TRUE;
 }
 
+// The sequence number for request is even, and the one for response is odd.
+#define SEQNUM_SLOT_COUNT   (SND_EFW_TRANSACTION_USER_SEQNUM_MAX / 2 + 1)
+
+// Reserve the range of sequence numbers without wrapping around. The range begins with zero when
+// it reaches the maximum.
+static guint32 reserve_seqnums(HitakiSndEfwPrivate *priv, guint count)
+{
+    guint32 curr;
+    guint32 head;
+    guint32 next;
+
+    do {
+        curr = g_atomic_int_get(&priv->seqnum);
+
+        head = curr;
+        if (head + (count - 1) * 2 > SND_EFW_TRANSACTION_USER_SEQNUM_MAX)
+            head = 0;
+
+        next = head + count * 2;
+        if (next > SND_EFW_TRANSACTION_USER_SEQNUM_MAX)
+            next = 0;
+    } while (!g_atomic_int_compare_and_exchange(&priv->seqnum, curr, next));
+
+    return head;
+}
+
 static void snd_efw_get_seqnum(HitakiEfwProtocol *inst, guint32 *seqnum)
 {
     HitakiSndEfw *self;
@@ -205,19 +265,30 @@ static void snd_efw_get_seqnum(HitakiEfwProtocol *inst, guint32 *seqnum)
     self = HITAKI_SND_EFW(inst);
     priv = hitaki_snd_efw_get_instance_private(self);
 
-    // Increment the sequence number for next transaction.
-    g_mutex_lock(&priv->lock);
-    *seqnum = priv->seqnum;
-    priv->seqnum += 2;
-    if (priv->seqnum > SND_EFW_TRANSACTION_USER_SEQNUM_MAX)
-        priv->seqnum = 0;
-    g_mutex_unlock(&priv->lock);
+    *seqnum = reserve_seqnums(priv, 1);
+}
+
+static gboolean snd_efw_reserve_seqnums(HitakiEfwProtocol *inst, guint count, guint32 *seqnum)
+{
+    HitakiSndEfw *self;
+    HitakiSndEfwPrivate *priv;
+
+    self = HITAKI_SND_EFW(inst);
+    priv = hitaki_snd_efw_get_instance_private(self);
+
+    if (count == 0 || count > SEQNUM_SLOT_COUNT)
+        return FALSE;
+
+    *seqnum = reserve_seqnums(priv, count);
+
+    return TRUE;
 }
 
 static void efw_protocol_iface_init(HitakiEfwProtocolInterface *iface)
 {
     iface->transmit_request = snd_efw_transmit_request;
     iface->get_seqnum = snd_efw_get_seqnum;
+    iface->reserve_seqnums = snd_efw_reserve_seqnums;
 }
 
 /**
@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 #include "alsa_firewire_private.h"
+#include "timestamped_quadlet_notification_private.h"
 
 /**
  * HitakiSndFireface:
@@ -84,6 +85,8 @@ typedef struct {
     struct alsa_firewire_state state;
 } HitakiSndFirefacePrivate;
 
+static void handle_event(HitakiAlsaFirewire *inst, const union snd_firewire_event *event,
+                         size_t length);
 static void alsa_firewire_iface_init(HitakiAlsaFirewireInterface *iface);
 static void timestamped_quadlet_notification_iface_init(HitakiTimestampedQuadletNotification *iface);
 
@@ -134,7 +137,7 @@ static void hitaki_snd_fireface_init(HitakiSndFireface *self)
 {
     HitakiSndFirefacePrivate *priv = hitaki_snd_fireface_get_instance_private(self);
 
-    alsa_firewire_state_init(&priv->state);
+    alsa_firewire_state_init(&priv->state, HITAKI_ALSA_FIREWIRE(self), handle_event);
 }
 
 static gboolean snd_fireface_open(HitakiAlsaFirewire *inst, const gchar *path, gint open_flag,
@@ -193,11 +196,31 @@ static void handle_event(HitakiAlsaFirewire *inst, const union snd_firewire_even
                          size_t length)
 {
     if (event->common.type == SNDRV_FIREWIRE_EVENT_FF400_MESSAGE) {
+        HitakiTimestampedQuadletNotification *self = HITAKI_TIMESTAMPED_QUADLET_NOTIFICATION(inst);
+        HitakiSndFirefacePrivate *priv =
+            hitaki_snd_fireface_get_instance_private(HITAKI_SND_FIREFACE(inst));
         const struct snd_firewire_event_ff400_message *ev = &event->ff400_message;
+        gboolean has_handler;
         int i;
 
-        for (i = 0; i < ev->message_count; ++i)
-            g_signal_emit_by_name(inst, "notified-at", ev->messages[i].message, ev->messages[i].tstamp);
+        has_handler = timestamped_quadlet_notification_has_handler(self);
+        if (!has_handler && priv->state.event_ring == NULL)
+            return;
+
+        for (i = 0; i < ev->message_count; ++i) {
+            guint32 values[] = {
+                ev->messages[i].message,
+                ev->messages[i].tstamp,
+            };
+
+            alsa_firewire_state_push_event(&priv->state, HITAKI_UNIT_EVENT_TYPE_NOTIFIED_AT,
+                                           values, G_N_ELEMENTS(values));
+
+            if (has_handler) {
+                timestamped_quadlet_notification_emit_notified_at(self, values[0], values[1]);
+                alsa_firewire_state_count_signals(&priv->state, 1);
+            }
+        }
     }
 }
 
@@ -212,7 +235,7 @@ static gboolean snd_fireface_create_source(HitakiAlsaFirewire *inst, GSource **s
     self = HITAKI_SND_FIREFACE(inst);
     priv = hitaki_snd_fireface_get_instance_private(self);
 
-    return alsa_firewire_state_create_source(&priv->state, inst, handle_event, source, error);
+    return alsa_firewire_state_create_source(&priv->state, source, error);
 }
 
 static void alsa_firewire_iface_init(HitakiAlsaFirewireInterface *iface)
@@ -1,5 +1,7 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 #include "alsa_firewire_private.h"
+#include "quadlet_notification_private.h"
+#include "motu_register_dsp_private.h"
 
 /**
  * HitakiSndMotu:
@@ -8,12 +10,23 @@
  * The [class@SndMotu] is an object class derived from [class@GObject.Object] with protocol
  * implementation for Mark of the Unicorn (MOTU) FireWire series supported by ALSA firewire-motu
  * driver (`snd-firewire-motu`).
+ *
+ * For register DSP models, the object keeps the cache of parameters. The cache is read at
+ * [method@AlsaFirewire.open], then patched by the events of change, thus
+ * [method@SndMotu.read_cached_parameter] can retrieve the parameters without any system call as
+ * long as the events are dispatched.
  */
 
 typedef struct {
     struct alsa_firewire_state state;
+
+    struct snd_firewire_motu_register_dsp_parameter param;
+    gboolean has_param;
+    GMutex param_lock;
 } HitakiSndMotuPrivate;
 
+static void handle_event(HitakiAlsaFirewire *inst, const union snd_firewire_event *event,
+                         size_t length);
 static void alsa_firewire_iface_init(HitakiAlsaFirewireInterface *iface);
 static void quadlet_notification_iface_init(HitakiQuadletNotificationInterface *iface);
 static void motu_register_dsp_iface_init(HitakiMotuRegisterDspInterface *iface);
@@ -51,6 +64,7 @@ static void snd_motu_finalize(GObject *obj)
     HitakiSndMotuPrivate *priv = hitaki_snd_motu_get_instance_private(self);
 
     alsa_firewire_state_release(&priv->state);
+    g_mutex_clear(&priv->param_lock);
 
     G_OBJECT_CLASS(hitaki_snd_motu_parent_class)->finalize(obj);
 }
@@ -70,7 +84,108 @@ static void hitaki_snd_motu_init(HitakiSndMotu *self)
 {
     HitakiSndMotuPrivate *priv = hitaki_snd_motu_get_instance_private(self);
 
-    alsa_firewire_state_init(&priv->state);
+    alsa_firewire_state_init(&priv->state, HITAKI_ALSA_FIREWIRE(self), handle_event);
+    priv->has_param = FALSE;
+    g_mutex_init(&priv->param_lock);
+}
+
+static guint8 *mixer_source_field(struct snd_firewire_motu_register_dsp_parameter *param,
+                                  HitakiMotuRegisterDspParameterType param_type, guint mixer)
+{
+    switch (param_type) {
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_GAIN:
+        return param->mixer.source[mixer].gain;
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_PAN:
+        return param->mixer.source[mixer].pan;
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_FLAG:
+        return param->mixer.source[mixer].flag;
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_PAIRED_BALANCE:
+        return param->mixer.source[mixer].paired_balance;
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_PAIRED_WIDTH:
+    default:
+        return param->mixer.source[mixer].paired_width;
+    }
+}
+
+static void patch_parameter(struct snd_firewire_motu_register_dsp_parameter *param, guint32 event)
+{
+    HitakiMotuRegisterDspParameterType param_type;
+    guint index0, index1;
+    guint8 value;
+
+    if (!motu_register_dsp_decode_event(event, &param_type, &index0, &index1, &value))
+        return;
+
+    switch (param_type) {
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_GAIN:
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_PAN:
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_FLAG:
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_PAIRED_BALANCE:
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_SOURCE_PAIRED_WIDTH:
+        mixer_source_field(param, param_type, index0)[index1] = value;
+        break;
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_OUTPUT_PAIRED_VOLUME:
+        param->mixer.output.paired_volume[index0] = value;
+        break;
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MIXER_OUTPUT_PAIRED_FLAG:
+        param->mixer.output.paired_flag[index0] = value;
+        break;
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_MAIN_OUTPUT_PAIRED_VOLUME:
+        param->output.main_paired_volume = value;
+        break;
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_HP_OUTPUT_PAIRED_VOLUME:
+        param->output.hp_paired_volume = value;
+        break;
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_HP_OUTPUT_PAIRED_ASSIGNMENT:
+        param->output.hp_paired_assignment = value;
+        break;
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_LINE_INPUT_BOOST:
+        param->line_input.boost_flag = value;
+        break;
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_LINE_INPUT_NOMINAL_LEVEL:
+        param->line_input.nominal_level_flag = value;
+        break;
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_INPUT_GAIN_AND_INVERT:
+        param->input.gain_and_invert[index0] = value;
+        break;
+    case HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_INPUT_FLAG:
+        param->input.flag[index0] = value;
+        break;
+    default:
+        break;
+    }
+}
+
+static void patch_cached_parameter(HitakiSndMotuPrivate *priv, const guint32 *events,
+                                   unsigned int count)
+{
+    int i;
+
+    g_mutex_lock(&priv->param_lock);
+    if (priv->has_param) {
+        for (i = 0; i < count; ++i)
+            patch_parameter(&priv->param, events[i]);
+    }
+    g_mutex_unlock(&priv->param_lock);
+}
+
+static gboolean fetch_cached_parameter(HitakiSndMotuPrivate *priv, GError **error)
+{
+    struct snd_firewire_motu_register_dsp_parameter param;
+
+    if (alsa_firewire_state_ioctl(&priv->state, SNDRV_FIREWIRE_IOCTL_MOTU_REGISTER_DSP_PARAMETER,
+                                  &param) < 0) {
+        generate_alsa_firewire_syscall_error(error, errno, "ioctl(%s)",
+                                             "SNDRV_FIREWIRE_IOCTL_MOTU_REGISTER_DSP_PARAMETER");
+        return FALSE;
+    }
+
+    g_mutex_lock(&priv->param_lock);
+    memcpy(&priv->param, &param, sizeof(param));
+    priv->has_param = TRUE;
+    g_mutex_unlock(&priv->param_lock);
+
+    return TRUE;
 }
 
 static gboolean snd_motu_open(HitakiAlsaFirewire *inst, const gchar *path, gint open_flag,
@@ -94,6 +209,12 @@ static gboolean snd_motu_open(HitakiAlsaFirewire *inst, const gchar *path, gint
         return FALSE;
     }
 
+    // Seed the cache of parameters. The models except for register DSP models reject it.
+    g_mutex_lock(&priv->param_lock);
+    priv->has_param = FALSE;
+    g_mutex_unlock(&priv->param_lock);
+    (void)fetch_cached_parameter(priv, NULL);
+
     return TRUE;
 }
 
@@ -128,17 +249,46 @@ static gboolean snd_motu_unlock(HitakiAlsaFirewire *inst, GError **error)
 static void handle_event(HitakiAlsaFirewire *inst, const union snd_firewire_event *event,
                          size_t length)
 {
+    HitakiSndMotuPrivate *priv = hitaki_snd_motu_get_instance_private(HITAKI_SND_MOTU(inst));
+
     if (event->common.type == SNDRV_FIREWIRE_EVENT_MOTU_NOTIFICATION) {
-        g_signal_emit_by_name(inst, "notified", event->motu_notification.message);
+        HitakiQuadletNotification *self = HITAKI_QUADLET_NOTIFICATION(inst);
+        guint32 message = event->motu_notification.message;
+
+        alsa_firewire_state_push_event(&priv->state, HITAKI_UNIT_EVENT_TYPE_NOTIFIED, &message, 1);
+
+        if (quadlet_notification_has_handler(self)) {
+            quadlet_notification_emit_notified(self, message);
+            alsa_firewire_state_count_signals(&priv->state, 1);
+        }
     } else if (event->common.type == SNDRV_FIREWIRE_EVENT_MOTU_REGISTER_DSP_CHANGE) {
+        HitakiMotuRegisterDsp *self = HITAKI_MOTU_REGISTER_DSP(inst);
         const struct snd_firewire_event_motu_register_dsp_change *ev;
         unsigned int count;
+        int i;
 
         ev = &event->motu_register_dsp_change;
         length -= sizeof(ev->type) + sizeof(ev->count);
         count = MIN(length / sizeof(*ev->changes), ev->count);
 
-        g_signal_emit_by_name(inst, "changed", &ev->changes, count);
+        patch_cached_parameter(priv, ev->changes, count);
+
+        if (priv->state.event_ring != NULL) {
+            for (i = 0; i < count; ++i)
+                alsa_firewire_state_push_event(&priv->state,
+                                               HITAKI_UNIT_EVENT_TYPE_MOTU_REGISTER_DSP_CHANGED,
+                                               &ev->changes[i], 1);
+        }
+
+        if (motu_register_dsp_has_handler(self, MOTU_REGISTER_DSP_SIG_CHANGED)) {
+            motu_register_dsp_emit_changed(self, ev->changes, count);
+            alsa_firewire_state_count_signals(&priv->state, 1);
+        }
+
+        if (motu_register_dsp_has_handler(self, MOTU_REGISTER_DSP_SIG_PARAMETER_CHANGED)) {
+            guint emitted = motu_register_dsp_emit_parameter_changed(self, ev->changes, count);
+            alsa_firewire_state_count_signals(&priv->state, emitted);
+        }
     }
 }
 
@@ -153,7 +303,7 @@ static gboolean snd_motu_create_source(HitakiAlsaFirewire *inst, GSource **sourc
     self = HITAKI_SND_MOTU(inst);
     priv = hitaki_snd_motu_get_instance_private(self);
 
-    return alsa_firewire_state_create_source(&priv->state, inst, handle_event, source, error);
+    return alsa_firewire_state_create_source(&priv->state, source, error);
 }
 
 static void alsa_firewire_iface_init(HitakiAlsaFirewireInterface *iface)
@@ -184,7 +334,7 @@ static gboolean operate_ioctl(HitakiSndMotu *self, unsigned long request, void *
         return FALSE;
     }
 
-    if (ioctl(priv->state.fd, request, arg) < 0) {
+    if (alsa_firewire_state_ioctl(&priv->state, request, arg) < 0) {
         generate_alsa_firewire_syscall_error(error, errno, "ioctl(%s)", request_label);
         return FALSE;
     }
@@ -196,15 +346,26 @@ static gboolean snd_motu_register_dsp_read_parameter(HitakiMotuRegisterDsp *inst
                                 HitakiSndMotuRegisterDspParameter *const *param, GError **error)
 {
     HitakiSndMotu *self;
+    HitakiSndMotuPrivate *priv;
 
     g_return_val_if_fail(HITAKI_IS_SND_MOTU(inst), FALSE);
     g_return_val_if_fail(param != NULL && *param != NULL, FALSE);
     g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
 
     self = HITAKI_SND_MOTU(inst);
+    priv = hitaki_snd_motu_get_instance_private(self);
+
+    if (!operate_ioctl(self, SNDRV_FIREWIRE_IOCTL_MOTU_REGISTER_DSP_PARAMETER, (void *)*param,
+                       "SNDRV_FIREWIRE_IOCTL_MOTU_REGISTER_DSP_PARAMETER", error))
+        return FALSE;
+
+    // Refresh the cache as well.
+    g_mutex_lock(&priv->param_lock);
+    memcpy(&priv->param, *param, sizeof(priv->param));
+    priv->has_param = TRUE;
+    g_mutex_unlock(&priv->param_lock);
 
-    return operate_ioctl(self, SNDRV_FIREWIRE_IOCTL_MOTU_REGISTER_DSP_PARAMETER, (void *)*param,
-                         "SNDRV_FIREWIRE_IOCTL_MOTU_REGISTER_DSP_PARAMETER", error);
+    return TRUE;
 }
 
 static gboolean snd_motu_register_dsp_read_byte_meter(HitakiMotuRegisterDsp *inst,
@@ -259,3 +420,46 @@ HitakiSndMotu *hitaki_snd_motu_new(void)
 {
     return g_object_new(HITAKI_TYPE_SND_MOTU, NULL);
 }
+
+/**
+ * hitaki_snd_motu_read_cached_parameter:
+ * @self: A [class@SndMotu].
+ * @param: (inout): A [struct@SndMotuRegisterDspParameter].
+ * @error: A [struct@GLib.Error] with Hitaki.AlsaFirewireError domain.
+ *
+ * Copy the snapshot of cached parameters for register DSP models. The cache is read from the
+ * device once, then patched by the events of change, thus the snapshot is up-to-date as long as
+ * the events are dispatched by the source from [method@AlsaFirewire.create_source].
+ *
+ * Returns: TRUE if the overall operation finished successfully, else FALSE.
+ */
+gboolean hitaki_snd_motu_read_cached_parameter(HitakiSndMotu *self,
+                                               HitakiSndMotuRegisterDspParameter *const *param,
+                                               GError **error)
+{
+    HitakiSndMotuPrivate *priv;
+    gboolean has_param;
+
+    g_return_val_if_fail(HITAKI_IS_SND_MOTU(self), FALSE);
+    g_return_val_if_fail(param != NULL && *param != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    priv = hitaki_snd_motu_get_instance_private(self);
+    if (priv->state.fd < 0) {
+        generate_alsa_firewire_error(error, HITAKI_ALSA_FIREWIRE_ERROR_IS_NOT_OPENED);
+        return FALSE;
+    }
+
+    g_mutex_lock(&priv->param_lock);
+    has_param = priv->has_param;
+    g_mutex_unlock(&priv->param_lock);
+
+    if (!has_param && !fetch_cached_parameter(priv, error))
+        return FALSE;
+
+    g_mutex_lock(&priv->param_lock);
+    memcpy(*param, &priv->param, sizeof(priv->param));
+    g_mutex_unlock(&priv->param_lock);
+
+    return TRUE;
+}
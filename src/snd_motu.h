@@ -16,6 +16,10 @@ struct _HitakiSndMotuClass {
 
 HitakiSndMotu *hitaki_snd_motu_new(void);
 
+gboolean hitaki_snd_motu_read_cached_parameter(HitakiSndMotu *self,
+                                               HitakiSndMotuRegisterDspParameter *const *param,
+                                               GError **error);
+
 G_END_DECLS
 
 #endif
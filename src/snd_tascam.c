@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 #include "alsa_firewire_private.h"
-#include "tascam_protocol.h"
+#include "tascam_protocol_private.h"
+#include "byteorder_private.h"
 
 /**
  * HitakiSndTascam:
@@ -10,14 +11,33 @@
  * implementation for TASCAM FireWire series supported by ALSA firewire-tascam driver
  * (`snd-firewire-tascam`). The image of state consists of 64 quadlets according to
  * `SNDRV_FIREWIRE_TASCAM_STATE_COUNT` in UAPI of ALSA firewire stack.
+ *
+ * The object maintains the mirror of the image in host endianness. The mirror is seeded by the
+ * image read at [method@AlsaFirewire.open], then updated by the changes in events, thus
+ * [method@SndTascam.read_cached_state] can retrieve the image without any system call. When the
+ * image is not available at [method@AlsaFirewire.open], the mirror is seeded at the first read of
+ * it. Each consumer can also retrieve the changes since its last look by
+ * [method@SndTascam.read_changes] with its own cursor.
  */
 
 typedef struct {
     struct alsa_firewire_state state;
 
     struct snd_firewire_tascam_state image;
+    gboolean coalesce;
+
+    // The mirror of image in host endianness, protected by sequence lock. The sequence is odd
+    // during update, and the half of it is the generation of mirror.
+    guint32 mirror[SNDRV_FIREWIRE_TASCAM_STATE_COUNT];
+    // The generation at which each quadlet of the mirror was changed at last.
+    guint generations[SNDRV_FIREWIRE_TASCAM_STATE_COUNT];
+    guint sequence;
+    gboolean is_seeded;
+    GMutex mirror_lock;
 } HitakiSndTascamPrivate;
 
+static void handle_event(HitakiAlsaFirewire *inst, const union snd_firewire_event *event,
+                         size_t length);
 static void alsa_firewire_iface_init(HitakiAlsaFirewireInterface *iface);
 static void tascam_protocol_iface_init(HitakiTascamProtocolInterface *iface);
 
@@ -26,12 +46,28 @@ G_DEFINE_TYPE_WITH_CODE(HitakiSndTascam, hitaki_snd_tascam, G_TYPE_OBJECT,
                         G_IMPLEMENT_INTERFACE(HITAKI_TYPE_ALSA_FIREWIRE, alsa_firewire_iface_init)
                         G_IMPLEMENT_INTERFACE(HITAKI_TYPE_TASCAM_PROTOCOL, tascam_protocol_iface_init));
 
+enum snd_tascam_prop_type {
+    SND_TASCAM_PROP_COALESCE = ALSA_FIREWIRE_PROP_COUNT,
+    SND_TASCAM_PROP_STATE_GENERATION,
+    SND_TASCAM_PROP_COUNT,
+};
+
+#define COALESCE_PROP_NAME          "coalesce"
+#define STATE_GENERATION_PROP_NAME  "state-generation"
+
 static void snd_tascam_set_property(GObject *inst, guint id, const GValue *val, GParamSpec *spec)
 {
     HitakiSndTascam *self = HITAKI_SND_TASCAM(inst);
     HitakiSndTascamPrivate *priv = hitaki_snd_tascam_get_instance_private(self);
 
-    alsa_firewire_state_set_property(&priv->state, inst, id, val, spec);
+    switch (id) {
+    case SND_TASCAM_PROP_COALESCE:
+        priv->coalesce = g_value_get_boolean(val);
+        break;
+    default:
+        alsa_firewire_state_set_property(&priv->state, inst, id, val, spec);
+        break;
+    }
 }
 
 static void snd_tascam_get_property(GObject *inst, guint id, GValue *val, GParamSpec *spec)
@@ -39,7 +75,17 @@ static void snd_tascam_get_property(GObject *inst, guint id, GValue *val, GParam
     HitakiSndTascam *self = HITAKI_SND_TASCAM(inst);
     HitakiSndTascamPrivate *priv = hitaki_snd_tascam_get_instance_private(self);
 
-    alsa_firewire_state_get_property(&priv->state, inst, id, val, spec);
+    switch (id) {
+    case SND_TASCAM_PROP_COALESCE:
+        g_value_set_boolean(val, priv->coalesce);
+        break;
+    case SND_TASCAM_PROP_STATE_GENERATION:
+        g_value_set_uint(val, (guint)g_atomic_int_get(&priv->sequence) / 2);
+        break;
+    default:
+        alsa_firewire_state_get_property(&priv->state, inst, id, val, spec);
+        break;
+    }
 }
 
 static void snd_tascam_finalize(GObject *obj)
@@ -48,6 +94,7 @@ static void snd_tascam_finalize(GObject *obj)
     HitakiSndTascamPrivate *priv = hitaki_snd_tascam_get_instance_private(self);
 
     alsa_firewire_state_release(&priv->state);
+    g_mutex_clear(&priv->mirror_lock);
 
     G_OBJECT_CLASS(hitaki_snd_tascam_parent_class)->finalize(obj);
 }
@@ -61,13 +108,131 @@ static void hitaki_snd_tascam_class_init(HitakiSndTascamClass *klass)
     gobject_class->finalize = snd_tascam_finalize;
 
     alsa_firewire_class_override_properties(gobject_class);
+
+    /**
+     * HitakiSndTascam:coalesce:
+     *
+     * Whether to coalesce the changes of the same index in one event. When enabled, the changes
+     * are collapsed into one change from the first value before the change to the last value
+     * after the change, in the order of the first appearance of the index. It is effective to
+     * reduce the number of signals when the fader is moved.
+     */
+    g_object_class_install_property(gobject_class, SND_TASCAM_PROP_COALESCE,
+        g_param_spec_boolean(COALESCE_PROP_NAME, COALESCE_PROP_NAME,
+                             "Whether to coalesce the changes of the same index in one event",
+                             FALSE,
+                             G_PARAM_READWRITE));
+
+    /**
+     * HitakiSndTascam:state-generation:
+     *
+     * The generation of mirror for the image of state. It is incremented every time the mirror
+     * is updated by the image read from the device or the changes in event. Without notification.
+     */
+    g_object_class_install_property(gobject_class, SND_TASCAM_PROP_STATE_GENERATION,
+        g_param_spec_uint(STATE_GENERATION_PROP_NAME, STATE_GENERATION_PROP_NAME,
+                          "The generation of mirror for the image of state",
+                          0, G_MAXUINT, 0,
+                          G_PARAM_READABLE));
 }
 
 static void hitaki_snd_tascam_init(HitakiSndTascam *self)
 {
     HitakiSndTascamPrivate *priv = hitaki_snd_tascam_get_instance_private(self);
 
-    alsa_firewire_state_init(&priv->state);
+    alsa_firewire_state_init(&priv->state, HITAKI_ALSA_FIREWIRE(self), handle_event);
+    priv->coalesce = FALSE;
+    g_mutex_init(&priv->mirror_lock);
+}
+
+// Return the generation of mirror after the update.
+static guint begin_mirror_update(HitakiSndTascamPrivate *priv)
+{
+    g_mutex_lock(&priv->mirror_lock);
+    g_atomic_int_inc(&priv->sequence);
+    // The odd sequence should be visible before any store to the mirror.
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    return ((guint)g_atomic_int_get(&priv->sequence) + 1) / 2;
+}
+
+static void update_mirror_quadlet(HitakiSndTascamPrivate *priv, unsigned int index, guint32 val,
+                                  guint generation)
+{
+    if ((guint32)g_atomic_int_get(&priv->mirror[index]) != val) {
+        g_atomic_int_set(&priv->mirror[index], val);
+        g_atomic_int_set(&priv->generations[index], generation);
+    }
+}
+
+static void end_mirror_update(HitakiSndTascamPrivate *priv)
+{
+    g_atomic_int_inc(&priv->sequence);
+    g_mutex_unlock(&priv->mirror_lock);
+}
+
+static void update_mirror_by_image(HitakiSndTascamPrivate *priv,
+                                   const struct snd_firewire_tascam_state *state)
+{
+    guint32 image[SNDRV_FIREWIRE_TASCAM_STATE_COUNT];
+    guint generation;
+    int i;
+
+    quadlets_from_be(image, state->data, SNDRV_FIREWIRE_TASCAM_STATE_COUNT);
+
+    generation = begin_mirror_update(priv);
+    for (i = 0; i < SNDRV_FIREWIRE_TASCAM_STATE_COUNT; ++i)
+        update_mirror_quadlet(priv, i, image[i], generation);
+    g_atomic_int_set(&priv->is_seeded, TRUE);
+    end_mirror_update(priv);
+}
+
+static void update_mirror_by_changes(HitakiSndTascamPrivate *priv, const guint32 *changes,
+                                     unsigned int count)
+{
+    guint generation;
+    int i;
+
+    generation = begin_mirror_update(priv);
+    for (i = 0; i < count; ++i) {
+        unsigned int index = changes[i * 3];
+
+        if (index < SNDRV_FIREWIRE_TASCAM_STATE_COUNT)
+            update_mirror_quadlet(priv, index, changes[i * 3 + 2], generation);
+    }
+    end_mirror_update(priv);
+}
+
+static gboolean read_image(HitakiSndTascamPrivate *priv, GError **error)
+{
+    if (alsa_firewire_state_ioctl(&priv->state, SNDRV_FIREWIRE_IOCTL_TASCAM_STATE,
+                                  &priv->image) < 0) {
+        generate_alsa_firewire_syscall_error(error, errno, "ioctl(%s)", "TASCAM_STATE");
+        return FALSE;
+    }
+
+    update_mirror_by_image(priv, &priv->image);
+
+    return TRUE;
+}
+
+// Seed the mirror unless it is seeded yet. The image is read into the local buffer since the
+// readers of mirror can call it at the same time.
+static gboolean seed_mirror(HitakiSndTascamPrivate *priv, GError **error)
+{
+    struct snd_firewire_tascam_state state;
+
+    if (g_atomic_int_get(&priv->is_seeded))
+        return TRUE;
+
+    if (alsa_firewire_state_ioctl(&priv->state, SNDRV_FIREWIRE_IOCTL_TASCAM_STATE, &state) < 0) {
+        generate_alsa_firewire_syscall_error(error, errno, "ioctl(%s)", "TASCAM_STATE");
+        return FALSE;
+    }
+
+    update_mirror_by_image(priv, &state);
+
+    return TRUE;
 }
 
 static gboolean snd_tascam_open(HitakiAlsaFirewire *inst, const gchar *path, gint open_flag,
@@ -91,6 +256,11 @@ static gboolean snd_tascam_open(HitakiAlsaFirewire *inst, const gchar *path, gin
         return FALSE;
     }
 
+    // Seed the mirror of image. When the image is not available, it is seeded at the first read
+    // of mirror.
+    g_atomic_int_set(&priv->is_seeded, FALSE);
+    (void)seed_mirror(priv, NULL);
+
     return TRUE;
 }
 
@@ -122,22 +292,100 @@ static gboolean snd_tascam_unlock(HitakiAlsaFirewire *inst, GError **error)
     return alsa_firewire_state_unlock(&priv->state, error);
 }
 
+static void decode_changes(guint32 *changes, const struct snd_firewire_tascam_change *change,
+                           unsigned int count)
+{
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        changes[i * 3] = change[i].index;
+        changes[i * 3 + 1] = GUINT32_FROM_BE(change[i].before);
+        changes[i * 3 + 2] = GUINT32_FROM_BE(change[i].after);
+    }
+}
+
+// Collapse the changes of the same index into one change from the first value before the change
+// to the last value after the change. The changes are kept in the order of the first appearance.
+static unsigned int coalesce_changes(guint32 *changes,
+                                     const struct snd_firewire_tascam_change *change,
+                                     unsigned int count)
+{
+    unsigned int positions[SNDRV_FIREWIRE_TASCAM_STATE_COUNT];
+    guint64 appeared = 0;
+    unsigned int coalesced = 0;
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        unsigned int index = change[i].index;
+        guint32 after = GUINT32_FROM_BE(change[i].after);
+
+        if (index < SNDRV_FIREWIRE_TASCAM_STATE_COUNT) {
+            if (appeared & (G_GUINT64_CONSTANT(1) << index)) {
+                changes[positions[index] * 3 + 2] = after;
+                continue;
+            }
+
+            appeared |= G_GUINT64_CONSTANT(1) << index;
+            positions[index] = coalesced;
+        }
+
+        changes[coalesced * 3] = index;
+        changes[coalesced * 3 + 1] = GUINT32_FROM_BE(change[i].before);
+        changes[coalesced * 3 + 2] = after;
+        ++coalesced;
+    }
+
+    return coalesced;
+}
+
 static void handle_event(HitakiAlsaFirewire *inst, const union snd_firewire_event *event,
                          size_t length)
 {
     if (event->common.type == SNDRV_FIREWIRE_EVENT_TASCAM_CONTROL) {
+        HitakiTascamProtocol *self = HITAKI_TASCAM_PROTOCOL(inst);
+        HitakiSndTascamPrivate *priv =
+            hitaki_snd_tascam_get_instance_private(HITAKI_SND_TASCAM(inst));
         const struct snd_firewire_event_tascam_control *ev = &event->tascam_control;
         const struct snd_firewire_tascam_change *change = ev->changes;
+        gboolean has_changed, has_changed_batch;
+        unsigned int count;
+        guint32 *changes;
+        int i;
 
         length -= sizeof(ev->type);
+        count = length / sizeof(*change);
+        if (count == 0)
+            return;
+
+        // The length of event is bound to the size of buffer, one page.
+        changes = g_alloca(sizeof(*changes) * 3 * count);
+
+        if (priv->coalesce)
+            count = coalesce_changes(changes, change, count);
+        else
+            decode_changes(changes, change, count);
+
+        update_mirror_by_changes(priv, changes, count);
+
+        has_changed = tascam_protocol_has_handler(self, TASCAM_PROTOCOL_SIG_CHANGED);
+        has_changed_batch = tascam_protocol_has_handler(self, TASCAM_PROTOCOL_SIG_CHANGED_BATCH);
+        if (!has_changed && !has_changed_batch && priv->state.event_ring == NULL)
+            return;
+
+        for (i = 0; i < count; ++i) {
+            alsa_firewire_state_push_event(&priv->state, HITAKI_UNIT_EVENT_TYPE_TASCAM_CHANGED,
+                                           changes + i * 3, 3);
+
+            if (has_changed) {
+                tascam_protocol_emit_changed(self, changes[i * 3], changes[i * 3 + 1],
+                                             changes[i * 3 + 2]);
+                alsa_firewire_state_count_signals(&priv->state, 1);
+            }
+        }
 
-        while (length >= sizeof(*change)) {
-            g_signal_emit_by_name(inst, "changed",
-                                  change->index,
-                                  GUINT32_FROM_BE(change->before),
-                                  GUINT32_FROM_BE(change->after));
-            ++change;
-            length -= sizeof(*change);
+        if (has_changed_batch) {
+            tascam_protocol_emit_changed_batch(self, changes, count * 3);
+            alsa_firewire_state_count_signals(&priv->state, 1);
         }
     }
 }
@@ -153,7 +401,7 @@ static gboolean snd_tascam_create_source(HitakiAlsaFirewire *inst, GSource **sou
     self = HITAKI_SND_TASCAM(inst);
     priv = hitaki_snd_tascam_get_instance_private(self);
 
-    return alsa_firewire_state_create_source(&priv->state, inst, handle_event, source, error);
+    return alsa_firewire_state_create_source(&priv->state, source, error);
 }
 
 static void alsa_firewire_iface_init(HitakiAlsaFirewireInterface *iface)
@@ -169,7 +417,6 @@ static gboolean snd_tascam_read_state(HitakiTascamProtocol *inst, guint32 *const
 {
     HitakiSndTascam *self;
     HitakiSndTascamPrivate *priv;
-    int i;
 
     g_return_val_if_fail(HITAKI_IS_SND_TASCAM(inst), FALSE);
     g_return_val_if_fail(state != NULL && *state != NULL, FALSE);
@@ -183,13 +430,10 @@ static gboolean snd_tascam_read_state(HitakiTascamProtocol *inst, guint32 *const
         return FALSE;
     }
 
-    if (ioctl(priv->state.fd, SNDRV_FIREWIRE_IOCTL_TASCAM_STATE, &priv->image) < 0) {
-        generate_alsa_firewire_syscall_error(error, errno, "ioctl(%s)", "TASCAM_STATE");
+    if (!read_image(priv, error))
         return FALSE;
-    }
 
-    for (i = 0; i < SNDRV_FIREWIRE_TASCAM_STATE_COUNT; ++i)
-        (*state)[i] = GUINT32_FROM_BE(priv->image.data[i]);
+    quadlets_from_be(*state, priv->image.data, SNDRV_FIREWIRE_TASCAM_STATE_COUNT);
     *count = SNDRV_FIREWIRE_TASCAM_STATE_COUNT;
 
     return TRUE;
@@ -211,3 +455,131 @@ HitakiSndTascam *hitaki_snd_tascam_new(void)
 {
     return g_object_new(HITAKI_TYPE_SND_TASCAM, NULL);
 }
+
+/**
+ * hitaki_snd_tascam_read_cached_state:
+ * @self: A [class@SndTascam].
+ * @state: (array length=count) (inout): The image of state.
+ * @count: (inout): The length of image for state.
+ * @generation: (out): The generation of mirror for the image.
+ * @error: A [struct@GLib.Error] with Hitaki.AlsaFirewireError domain.
+ *
+ * Read the image of state from the mirror maintained by the changes in events, without any
+ * system call except for the first read when the mirror is not seeded at
+ * [method@AlsaFirewire.open]. The generation is the same as the value of [property@SndTascam:state-generation]
+ * at the read.
+ *
+ * Returns: TRUE if the overall operation finished successfully, else FALSE.
+ */
+gboolean hitaki_snd_tascam_read_cached_state(HitakiSndTascam *self, guint32 *const *state,
+                                             gsize *count, guint *generation, GError **error)
+{
+    HitakiSndTascamPrivate *priv;
+    guint sequence;
+    int i;
+
+    g_return_val_if_fail(HITAKI_IS_SND_TASCAM(self), FALSE);
+    g_return_val_if_fail(state != NULL && *state != NULL, FALSE);
+    g_return_val_if_fail(count != NULL && *count >= SNDRV_FIREWIRE_TASCAM_STATE_COUNT, FALSE);
+    g_return_val_if_fail(generation != NULL, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    priv = hitaki_snd_tascam_get_instance_private(self);
+    if (priv->state.fd < 0) {
+        generate_alsa_firewire_error(error, HITAKI_ALSA_FIREWIRE_ERROR_IS_NOT_OPENED);
+        return FALSE;
+    }
+
+    if (!seed_mirror(priv, error))
+        return FALSE;
+
+    do {
+        sequence = g_atomic_int_get(&priv->sequence);
+        if (sequence & 1)
+            continue;
+
+        for (i = 0; i < SNDRV_FIREWIRE_TASCAM_STATE_COUNT; ++i)
+            (*state)[i] = g_atomic_int_get(&priv->mirror[i]);
+
+        // The loads above should not be reordered after the load of sequence below.
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while ((sequence & 1) || sequence != (guint)g_atomic_int_get(&priv->sequence));
+
+    *count = SNDRV_FIREWIRE_TASCAM_STATE_COUNT;
+    *generation = sequence / 2;
+
+    return TRUE;
+}
+
+/**
+ * hitaki_snd_tascam_read_changes:
+ * @self: A [class@SndTascam].
+ * @cursor: (inout): The generation of mirror at the last read by the consumer. It is updated to
+ *          the generation at the read.
+ * @mask: (out): The mask of bits for the quadlets changed since the cursor. The least significant
+ *        bit corresponds to the first quadlet in the image.
+ * @values: (array length=count) (inout): The values of changed quadlets, in the order of bits in
+ *          the mask.
+ * @count: (inout): The length of array for values, at least 64. It is updated to the number of
+ *         changed quadlets.
+ * @error: A [struct@GLib.Error] with Hitaki.AlsaFirewireError domain.
+ *
+ * Read the quadlets of mirror changed since the generation of the cursor, without any system
+ * call except for the first read when the mirror is not seeded at [method@AlsaFirewire.open].
+ * Each consumer keeps its own cursor, initialized to zero so that the first read retrieves
+ * the quadlets different from zero in the image.
+ *
+ * Returns: TRUE if the overall operation finished successfully, else FALSE.
+ */
+gboolean hitaki_snd_tascam_read_changes(HitakiSndTascam *self, guint *cursor, guint64 *mask,
+                                        guint32 *const *values, gsize *count, GError **error)
+{
+    HitakiSndTascamPrivate *priv;
+    guint sequence;
+    guint64 bits;
+    gsize length;
+    int i;
+
+    g_return_val_if_fail(HITAKI_IS_SND_TASCAM(self), FALSE);
+    g_return_val_if_fail(cursor != NULL, FALSE);
+    g_return_val_if_fail(mask != NULL, FALSE);
+    g_return_val_if_fail(values != NULL && *values != NULL, FALSE);
+    g_return_val_if_fail(count != NULL && *count >= SNDRV_FIREWIRE_TASCAM_STATE_COUNT, FALSE);
+    g_return_val_if_fail(error == NULL || *error == NULL, FALSE);
+
+    priv = hitaki_snd_tascam_get_instance_private(self);
+    if (priv->state.fd < 0) {
+        generate_alsa_firewire_error(error, HITAKI_ALSA_FIREWIRE_ERROR_IS_NOT_OPENED);
+        return FALSE;
+    }
+
+    if (!seed_mirror(priv, error))
+        return FALSE;
+
+    do {
+        sequence = g_atomic_int_get(&priv->sequence);
+        if (sequence & 1)
+            continue;
+
+        bits = 0;
+        length = 0;
+        for (i = 0; i < SNDRV_FIREWIRE_TASCAM_STATE_COUNT; ++i) {
+            guint generation = g_atomic_int_get(&priv->generations[i]);
+
+            // Compare by difference for wrap-around of generation.
+            if ((gint)(generation - *cursor) > 0) {
+                bits |= G_GUINT64_CONSTANT(1) << i;
+                (*values)[length++] = g_atomic_int_get(&priv->mirror[i]);
+            }
+        }
+
+        // The loads above should not be reordered after the load of sequence below.
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while ((sequence & 1) || sequence != (guint)g_atomic_int_get(&priv->sequence));
+
+    *cursor = sequence / 2;
+    *mask = bits;
+    *count = length;
+
+    return TRUE;
+}
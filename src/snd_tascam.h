@@ -16,6 +16,12 @@ struct _HitakiSndTascamClass {
 
 HitakiSndTascam *hitaki_snd_tascam_new(void);
 
+gboolean hitaki_snd_tascam_read_cached_state(HitakiSndTascam *self, guint32 *const *state,
+                                             gsize *count, guint *generation, GError **error);
+
+gboolean hitaki_snd_tascam_read_changes(HitakiSndTascam *self, guint *cursor, guint64 *mask,
+                                        guint32 *const *values, gsize *count, GError **error);
+
 G_END_DECLS
 
 #endif
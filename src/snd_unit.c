@@ -13,6 +13,8 @@ typedef struct {
     struct alsa_firewire_state state;
 } HitakiSndUnitPrivate;
 
+static void handle_event(HitakiAlsaFirewire *inst, const union snd_firewire_event *event,
+                         size_t length);
 static void alsa_firewire_iface_init(HitakiAlsaFirewireInterface *iface);
 
 G_DEFINE_TYPE_WITH_CODE(HitakiSndUnit, hitaki_snd_unit, G_TYPE_OBJECT,
@@ -60,7 +62,7 @@ static void hitaki_snd_unit_init(HitakiSndUnit *self)
 {
     HitakiSndUnitPrivate *priv = hitaki_snd_unit_get_instance_private(self);
 
-    alsa_firewire_state_init(&priv->state);
+    alsa_firewire_state_init(&priv->state, HITAKI_ALSA_FIREWIRE(self), handle_event);
 }
 
 static gboolean snd_unit_open(HitakiAlsaFirewire *inst, const gchar *path, gint open_flag,
@@ -124,7 +126,7 @@ static gboolean snd_unit_create_source(HitakiAlsaFirewire *inst, GSource **sourc
     self = HITAKI_SND_UNIT(inst);
     priv = hitaki_snd_unit_get_instance_private(self);
 
-    return alsa_firewire_state_create_source(&priv->state, inst, handle_event, source, error);
+    return alsa_firewire_state_create_source(&priv->state, source, error);
 }
 
 static void alsa_firewire_iface_init(HitakiAlsaFirewireInterface *iface)
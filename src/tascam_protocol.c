@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
-#include "tascam_protocol.h"
+#include "tascam_protocol_private.h"
+#include "trace_private.h"
 
 /**
  * HitakiTascamProtocol:
@@ -11,6 +12,8 @@
  */
 G_DEFINE_INTERFACE(HitakiTascamProtocol, hitaki_tascam_protocol, G_TYPE_OBJECT)
 
+static guint tascam_protocol_sigs[TASCAM_PROTOCOL_SIG_COUNT] = { 0 };
+
 static void hitaki_tascam_protocol_default_init(HitakiTascamProtocolInterface *iface)
 {
     /**
@@ -22,14 +25,76 @@ static void hitaki_tascam_protocol_default_init(HitakiTascamProtocolInterface *i
      *
      * Emitted when the part of image differed for the change of device state.
      */
-    g_signal_new("changed",
-                 G_TYPE_FROM_INTERFACE(iface),
-                 G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
-                 G_STRUCT_OFFSET(HitakiTascamProtocolInterface, changed),
-                 NULL, NULL,
-                 hitaki_sigs_marshal_VOID__UINT_UINT_UINT,
-                 G_TYPE_NONE,
-                 3, G_TYPE_UINT, G_TYPE_UINT, G_TYPE_UINT);
+    tascam_protocol_sigs[TASCAM_PROTOCOL_SIG_CHANGED] =
+        g_signal_new("changed",
+                     G_TYPE_FROM_INTERFACE(iface),
+                     G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
+                     G_STRUCT_OFFSET(HitakiTascamProtocolInterface, changed),
+                     NULL, NULL,
+                     hitaki_sigs_marshal_VOID__UINT_UINT_UINT,
+                     G_TYPE_NONE,
+                     3, G_TYPE_UINT, G_TYPE_UINT, G_TYPE_UINT);
+
+    /**
+     * HitakiTascamProtocol::changed-batch:
+     * @self: A [iface@TascamProtocol]
+     * @changes: (element-type guint32) (array length=length): The array with elements for triples
+     *           of the numeric index on image, the value before changed, and the value after
+     *           changed.
+     * @length: The number of elements in the array, three times as many as the changes.
+     *
+     * Emitted once for all of the changes of device state delivered together, after the
+     * [signal@TascamProtocol::changed] signal is emitted for each of them.
+     */
+    tascam_protocol_sigs[TASCAM_PROTOCOL_SIG_CHANGED_BATCH] =
+        g_signal_new("changed-batch",
+                     G_TYPE_FROM_INTERFACE(iface),
+                     G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
+                     G_STRUCT_OFFSET(HitakiTascamProtocolInterface, changed_batch),
+                     NULL, NULL,
+                     hitaki_sigs_marshal_VOID__POINTER_UINT,
+                     G_TYPE_NONE,
+                     2, G_TYPE_POINTER, G_TYPE_UINT);
+}
+
+// Any class closure or signal handler to receive the signal.
+gboolean tascam_protocol_has_handler(HitakiTascamProtocol *self,
+                                     enum tascam_protocol_sig_type type)
+{
+    HitakiTascamProtocolInterface *iface = HITAKI_TASCAM_PROTOCOL_GET_IFACE(self);
+    gboolean has_class_closure;
+
+    switch (type) {
+    case TASCAM_PROTOCOL_SIG_CHANGED:
+        has_class_closure = iface->changed != NULL;
+        break;
+    case TASCAM_PROTOCOL_SIG_CHANGED_BATCH:
+        has_class_closure = iface->changed_batch != NULL;
+        break;
+    default:
+        return FALSE;
+    }
+
+    return has_class_closure ||
+           g_signal_has_handler_pending(self, tascam_protocol_sigs[type], 0, FALSE);
+}
+
+void tascam_protocol_emit_changed(HitakiTascamProtocol *self, guint index, guint before,
+                                  guint after)
+{
+    TRACE_PROBE2(signal_emit_entry, self, "changed");
+    g_signal_emit(self, tascam_protocol_sigs[TASCAM_PROTOCOL_SIG_CHANGED], 0, index, before,
+                  after);
+    TRACE_PROBE2(signal_emit_exit, self, "changed");
+}
+
+void tascam_protocol_emit_changed_batch(HitakiTascamProtocol *self, const guint32 *changes,
+                                        guint length)
+{
+    TRACE_PROBE2(signal_emit_entry, self, "changed-batch");
+    g_signal_emit(self, tascam_protocol_sigs[TASCAM_PROTOCOL_SIG_CHANGED_BATCH], 0, changes,
+                  length);
+    TRACE_PROBE2(signal_emit_exit, self, "changed-batch");
 }
 
 /**
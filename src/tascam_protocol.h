@@ -37,6 +37,18 @@ struct _HitakiTascamProtocolInterface {
      * Class closure for the [signal@TascamProtocol::changed] signal.
      */
     void (*changed)(HitakiTascamProtocol *self, guint index, guint before, guint after);
+
+    /**
+     * HitakiTascamProtocolInterface::changed_batch:
+     * @self: A [iface@TascamProtocol]
+     * @changes: (element-type guint32)(array length=length): The array with elements for triples
+     *           of the numeric index on image, the value before changed, and the value after
+     *           changed.
+     * @length: The number of elements in the array, three times as many as the changes.
+     *
+     * Class closure for the [signal@TascamProtocol::changed-batch] signal.
+     */
+    void (*changed_batch)(HitakiTascamProtocol *self, const guint32 *changes, guint length);
 };
 
 gboolean hitaki_tascam_protocol_read_state(HitakiTascamProtocol *self, guint32 *const *state,
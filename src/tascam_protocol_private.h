@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#ifndef __HITAKI_TASCAM_PROTOCOL_PRIVATE_H__
+#define __HITAKI_TASCAM_PROTOCOL_PRIVATE_H__
+
+#include "hitaki.h"
+
+enum tascam_protocol_sig_type {
+    TASCAM_PROTOCOL_SIG_CHANGED = 0,
+    TASCAM_PROTOCOL_SIG_CHANGED_BATCH,
+    TASCAM_PROTOCOL_SIG_COUNT,
+};
+
+gboolean tascam_protocol_has_handler(HitakiTascamProtocol *self,
+                                     enum tascam_protocol_sig_type type);
+
+void tascam_protocol_emit_changed(HitakiTascamProtocol *self, guint index, guint before,
+                                  guint after);
+
+void tascam_protocol_emit_changed_batch(HitakiTascamProtocol *self, const guint32 *changes,
+                                        guint length);
+
+#endif
@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
-#include "timestamped_quadlet_notification.h"
+#include "timestamped_quadlet_notification_private.h"
+#include "trace_private.h"
 
 /**
  * HitakiTimestampedQuadletNotification:
@@ -11,6 +12,12 @@
  */
 G_DEFINE_INTERFACE(HitakiTimestampedQuadletNotification, hitaki_timestamped_quadlet_notification, G_TYPE_OBJECT)
 
+enum timestamped_quadlet_notification_sig_type {
+    TIMESTAMPED_QUADLET_NOTIFICATION_SIG_NOTIFIED_AT = 0,
+    TIMESTAMPED_QUADLET_NOTIFICATION_SIG_COUNT,
+};
+static guint timestamped_quadlet_notification_sigs[TIMESTAMPED_QUADLET_NOTIFICATION_SIG_COUNT] = { 0 };
+
 static void hitaki_timestamped_quadlet_notification_default_init(HitakiTimestampedQuadletNotificationInterface *iface)
 {
     /**
@@ -25,11 +32,31 @@ static void hitaki_timestamped_quadlet_notification_default_init(HitakiTimestamp
      * bits of second field and the rest 13 bits for cycle field in the format of IEEE 1394
      * CYCLE_TIMER register.
      */
-    g_signal_new("notified-at",
-                 G_TYPE_FROM_INTERFACE(iface),
-                 G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
-                 G_STRUCT_OFFSET(HitakiTimestampedQuadletNotificationInterface, notified_at),
-                 NULL, NULL,
-                 hitaki_sigs_marshal_VOID__UINT_UINT,
-                 G_TYPE_NONE, 2, G_TYPE_UINT, G_TYPE_UINT);
+    timestamped_quadlet_notification_sigs[TIMESTAMPED_QUADLET_NOTIFICATION_SIG_NOTIFIED_AT] =
+        g_signal_new("notified-at",
+                     G_TYPE_FROM_INTERFACE(iface),
+                     G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
+                     G_STRUCT_OFFSET(HitakiTimestampedQuadletNotificationInterface, notified_at),
+                     NULL, NULL,
+                     hitaki_sigs_marshal_VOID__UINT_UINT,
+                     G_TYPE_NONE, 2, G_TYPE_UINT, G_TYPE_UINT);
+}
+
+// Any class closure or signal handler to receive the signal.
+gboolean timestamped_quadlet_notification_has_handler(HitakiTimestampedQuadletNotification *self)
+{
+    guint id = timestamped_quadlet_notification_sigs[TIMESTAMPED_QUADLET_NOTIFICATION_SIG_NOTIFIED_AT];
+
+    return HITAKI_TIMESTAMPED_QUADLET_NOTIFICATION_GET_IFACE(self)->notified_at != NULL ||
+           g_signal_has_handler_pending(self, id, 0, FALSE);
+}
+
+void timestamped_quadlet_notification_emit_notified_at(HitakiTimestampedQuadletNotification *self,
+                                                       guint32 message, guint32 tstamp)
+{
+    guint id = timestamped_quadlet_notification_sigs[TIMESTAMPED_QUADLET_NOTIFICATION_SIG_NOTIFIED_AT];
+
+    TRACE_PROBE2(signal_emit_entry, self, "notified-at");
+    g_signal_emit(self, id, 0, message, tstamp);
+    TRACE_PROBE2(signal_emit_exit, self, "notified-at");
 }
@@ -0,0 +1,12 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#ifndef __HITAKI_TIMESTAMPED_QUADLET_NOTIFICATION_PRIVATE_H__
+#define __HITAKI_TIMESTAMPED_QUADLET_NOTIFICATION_PRIVATE_H__
+
+#include "hitaki.h"
+
+gboolean timestamped_quadlet_notification_has_handler(HitakiTimestampedQuadletNotification *self);
+
+void timestamped_quadlet_notification_emit_notified_at(HitakiTimestampedQuadletNotification *self,
+                                                       guint32 message, guint32 tstamp);
+
+#endif
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#ifndef __HITAKI_TRACE_PRIVATE_H__
+#define __HITAKI_TRACE_PRIVATE_H__
+
+// The static probes compatible with SystemTap SDT under 'hitaki' provider. They are available for
+// perf(1), bpftrace(8), and so on, when the library is built with 'trace' option. Each probe is
+// just a nop instruction unless it is attached, and it is compiled out without the option.
+
+#ifdef HITAKI_ENABLE_TRACE
+
+#include <sys/sdt.h>
+
+#define TRACE_PROBE1(name, a1)                                                          \
+    DTRACE_PROBE1(hitaki, name, a1)
+#define TRACE_PROBE2(name, a1, a2)                                                      \
+    DTRACE_PROBE2(hitaki, name, a1, a2)
+#define TRACE_PROBE3(name, a1, a2, a3)                                                  \
+    DTRACE_PROBE3(hitaki, name, a1, a2, a3)
+#define TRACE_PROBE4(name, a1, a2, a3, a4)                                              \
+    DTRACE_PROBE4(hitaki, name, a1, a2, a3, a4)
+#define TRACE_PROBE5(name, a1, a2, a3, a4, a5)                                          \
+    DTRACE_PROBE5(hitaki, name, a1, a2, a3, a4, a5)
+#define TRACE_PROBE6(name, a1, a2, a3, a4, a5, a6)                                      \
+    DTRACE_PROBE6(hitaki, name, a1, a2, a3, a4, a5, a6)
+
+#else
+
+// The arguments are discarded so that the variables only for the probes are not reported as
+// unused.
+#define TRACE_PROBE1(name, a1)                                                          \
+    do { (void)(a1); } while (0)
+#define TRACE_PROBE2(name, a1, a2)                                                      \
+    do { (void)(a1); (void)(a2); } while (0)
+#define TRACE_PROBE3(name, a1, a2, a3)                                                  \
+    do { (void)(a1); (void)(a2); (void)(a3); } while (0)
+#define TRACE_PROBE4(name, a1, a2, a3, a4)                                              \
+    do { (void)(a1); (void)(a2); (void)(a3); (void)(a4); } while (0)
+#define TRACE_PROBE5(name, a1, a2, a3, a4, a5)                                          \
+    do { (void)(a1); (void)(a2); (void)(a3); (void)(a4); (void)(a5); } while (0)
+#define TRACE_PROBE6(name, a1, a2, a3, a4, a5, a6)                                      \
+    do { (void)(a1); (void)(a2); (void)(a3); (void)(a4); (void)(a5); (void)(a6); } while (0)
+
+#endif
+
+#endif
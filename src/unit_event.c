@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#include "event_ring_private.h"
+
+#include <string.h>
+
+/**
+ * HitakiUnitEvent:
+ * A boxed object for decoded event from sound unit.
+ *
+ * A [struct@UnitEvent] is a boxed object with fixed size for the event decoded from ALSA HwDep
+ * character device. It is retrieved from [class@EventRing].
+ */
+HitakiUnitEvent *unit_event_copy(const HitakiUnitEvent *self)
+{
+#ifdef g_memdup2
+    return g_memdup2(self, sizeof(*self));
+#else
+    // GLib v2.68 deprecated g_memdup() with concern about overflow by narrow conversion from size_t to
+    // unsigned int however it's safe in the local case.
+    gpointer ptr = g_malloc(sizeof(*self));
+    memcpy(ptr, self, sizeof(*self));
+    return ptr;
+#endif
+}
+
+G_DEFINE_BOXED_TYPE(HitakiUnitEvent, hitaki_unit_event, unit_event_copy, g_free)
+
+/**
+ * hitaki_unit_event_new:
+ *
+ * Instantiate [struct@UnitEvent] object and return the instance.
+ *
+ * Returns: an instance of [struct@UnitEvent].
+ */
+HitakiUnitEvent *hitaki_unit_event_new(void)
+{
+    return g_malloc0(sizeof(HitakiUnitEvent));
+}
+
+/**
+ * hitaki_unit_event_get_event_type:
+ * @self: A [struct@UnitEvent].
+ * @event_type: (out): The type of event.
+ *
+ * Get the type of event.
+ */
+void hitaki_unit_event_get_event_type(const HitakiUnitEvent *self, HitakiUnitEventType *event_type)
+{
+    const struct unit_event *ev;
+
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(event_type != NULL);
+
+    ev = (const struct unit_event *)self;
+    *event_type = (HitakiUnitEventType)ev->type;
+}
+
+/**
+ * hitaki_unit_event_get_card_id:
+ * @self: A [struct@UnitEvent].
+ * @card_id: (out): The numeric identifier of sound card which generates the event.
+ *
+ * Get the numeric identifier of sound card which generates the event.
+ */
+void hitaki_unit_event_get_card_id(const HitakiUnitEvent *self, guint *card_id)
+{
+    const struct unit_event *ev;
+
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(card_id != NULL);
+
+    ev = (const struct unit_event *)self;
+    *card_id = ev->card_id;
+}
+
+/**
+ * hitaki_unit_event_get_values:
+ * @self: A [struct@UnitEvent].
+ * @values: (array fixed-size=6)(out)(transfer none): The array with elements for the values of
+ *          event.
+ *
+ * Get the array with elements for the values of event. The layout depends on the type of event:
+ *
+ * - [enum@Hitaki.UnitEventType.NOTIFIED]: the message.
+ * - [enum@Hitaki.UnitEventType.NOTIFIED_AT]: the message and the time stamp.
+ * - [enum@Hitaki.UnitEventType.TASCAM_CHANGED]: the index, the value before and after the change.
+ * - [enum@Hitaki.UnitEventType.MOTU_REGISTER_DSP_CHANGED]: the encoded change of parameter.
+ * - [enum@Hitaki.UnitEventType.EFW_RESPONDED]: the version, the sequence number, the category,
+ *   the command, the status, and the number of parameters in header of response. The parameters
+ *   are not included.
+ *
+ * The rest of elements are zero.
+ */
+void hitaki_unit_event_get_values(const HitakiUnitEvent *self, const guint32 *values[6])
+{
+    const struct unit_event *ev;
+
+    g_return_if_fail(self != NULL);
+    g_return_if_fail(values != NULL);
+
+    ev = (const struct unit_event *)self;
+    *values = ev->values;
+}
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#ifndef __HITAKI_UNIT_EVENT_H__
+#define __HITAKI_UNIT_EVENT_H__
+
+#include <hitaki.h>
+
+G_BEGIN_DECLS
+
+#define HITAKI_TYPE_UNIT_EVENT  (hitaki_unit_event_get_type())
+
+typedef struct {
+    /*< private >*/
+    guint32 reserved[8];
+} HitakiUnitEvent;
+
+GType hitaki_unit_event_get_type() G_GNUC_CONST;
+
+HitakiUnitEvent *hitaki_unit_event_new(void);
+
+void hitaki_unit_event_get_event_type(const HitakiUnitEvent *self, HitakiUnitEventType *event_type);
+
+void hitaki_unit_event_get_card_id(const HitakiUnitEvent *self, guint *card_id);
+
+void hitaki_unit_event_get_values(const HitakiUnitEvent *self, const guint32 *values[6]);
+
+G_END_DECLS
+
+#endif
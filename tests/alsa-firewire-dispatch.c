@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#include "loopback-helper.h"
+
+// Check the number of events handled in one dispatch of the source against the loopback device,
+// and removal of the source at the end of file.
+
+#define EVENT_COUNT     10
+#define BUDGET          4
+
+struct fixture {
+    struct loopback_fixture loopback;
+    guint calls;
+};
+
+static void handle_notified(HitakiQuadletNotification *unit, guint32 message, gpointer user_data)
+{
+    struct fixture *fixture = user_data;
+
+    g_assert_cmpuint(message, ==, fixture->calls);
+    ++fixture->calls;
+}
+
+static void setup(struct fixture *fixture, gint open_flag, guint budget)
+{
+    loopback_fixture_setup(&fixture->loopback, HITAKI_TYPE_SND_DICE, "dice", open_flag);
+    g_object_set(fixture->loopback.unit, DISPATCH_BUDGET_PROP_NAME, budget, NULL);
+    g_signal_connect(fixture->loopback.unit, "notified", G_CALLBACK(handle_notified), fixture);
+    fixture->calls = 0;
+}
+
+static void teardown(struct fixture *fixture)
+{
+    loopback_fixture_teardown(&fixture->loopback);
+}
+
+static void inject_events(struct fixture *fixture, guint count)
+{
+    struct snd_firewire_event_dice_notification event = {
+        .type = SNDRV_FIREWIRE_EVENT_DICE_NOTIFICATION,
+    };
+    GError *error = NULL;
+    guint i;
+
+    for (i = 0; i < count; ++i) {
+        event.notification = i;
+        alsa_firewire_loopback_inject_event(fixture->loopback.state,
+                                            (const union snd_firewire_event *)&event,
+                                            sizeof(event), &error);
+        g_assert_no_error(error);
+    }
+}
+
+// One dispatch handles the queued events up to the budget, and the rest are left to the next
+// iteration.
+static void test_budget(gconstpointer data)
+{
+    gint open_flag = GPOINTER_TO_INT(data);
+    struct fixture fixture;
+    guint expected = 0;
+
+    setup(&fixture, open_flag, BUDGET);
+    inject_events(&fixture, EVENT_COUNT);
+
+    while (expected < EVENT_COUNT) {
+        expected += MIN(EVENT_COUNT - expected, BUDGET);
+        g_assert_true(g_main_context_iteration(fixture.loopback.ctx, FALSE));
+        g_assert_cmpuint(fixture.calls, ==, expected);
+    }
+
+    g_main_context_iteration(fixture.loopback.ctx, FALSE);
+    g_assert_cmpuint(fixture.calls, ==, EVENT_COUNT);
+    g_assert_false(g_source_is_destroyed(fixture.loopback.src));
+
+    teardown(&fixture);
+}
+
+// The source is removed at the end of file after handling the queued events, instead of busy loop.
+static void test_end_of_file(gconstpointer data)
+{
+    gint open_flag = GPOINTER_TO_INT(data);
+    struct fixture fixture;
+    GError *error = NULL;
+    guint i;
+
+    setup(&fixture, open_flag, BUDGET);
+    // Drain all of events within the budget so that the last read(2) leaves EAGAIN in errno.
+    inject_events(&fixture, BUDGET - 1);
+    g_main_context_iteration(fixture.loopback.ctx, FALSE);
+    g_assert_cmpuint(fixture.calls, ==, BUDGET - 1);
+
+    alsa_firewire_loopback_hang_up(fixture.loopback.state, &error);
+    g_assert_no_error(error);
+
+    for (i = 0; i < 2 && !g_source_is_destroyed(fixture.loopback.src); ++i)
+        g_main_context_iteration(fixture.loopback.ctx, FALSE);
+    g_assert_true(g_source_is_destroyed(fixture.loopback.src));
+    g_assert_false(g_main_context_iteration(fixture.loopback.ctx, FALSE));
+
+    teardown(&fixture);
+}
+
+int main(int argc, char **argv)
+{
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_data_func("/alsa-firewire/dispatch/budget/nonblocking",
+                         GINT_TO_POINTER(O_NONBLOCK), test_budget);
+    g_test_add_data_func("/alsa-firewire/dispatch/budget/blocking", GINT_TO_POINTER(0),
+                         test_budget);
+    g_test_add_data_func("/alsa-firewire/dispatch/end-of-file/nonblocking",
+                         GINT_TO_POINTER(O_NONBLOCK), test_end_of_file);
+    g_test_add_data_func("/alsa-firewire/dispatch/end-of-file/blocking", GINT_TO_POINTER(0),
+                         test_end_of_file);
+
+    return g_test_run();
+}
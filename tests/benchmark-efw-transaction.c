@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#include "alsa_firewire_private.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Measure the round trip of Fireworks transaction. The loopback device stands in for the
+// responder, and answers each request frame immediately. The response is dispatched by the
+// thread running the main loop, as applications usually do.
+
+#define TRANSACTION_COUNT   20000
+#define WARMUP_COUNT        1000
+#define TIMEOUT_MS          100
+#define ARG_COUNT           4
+
+struct dispatcher {
+    GMainContext *ctx;
+    GMainLoop *loop;
+    GThread *thread;
+};
+
+static gint64 get_monotonic_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (gint64)ts.tv_sec * G_GINT64_CONSTANT(1000000000) + ts.tv_nsec;
+}
+
+static void fail(const gchar *label, GError *error)
+{
+    fprintf(stderr, "%s: %s\n", label, error != NULL ? error->message : "unknown");
+    exit(EXIT_FAILURE);
+}
+
+static gpointer run_dispatcher(gpointer data)
+{
+    struct dispatcher *dispatcher = data;
+
+    g_main_context_push_thread_default(dispatcher->ctx);
+    g_main_loop_run(dispatcher->loop);
+    g_main_context_pop_thread_default(dispatcher->ctx);
+
+    return NULL;
+}
+
+static gboolean quit_loop(gpointer data)
+{
+    g_main_loop_quit(data);
+    return G_SOURCE_REMOVE;
+}
+
+static gint compare_latency(gconstpointer a, gconstpointer b)
+{
+    gint64 lhs = *(const gint64 *)a;
+    gint64 rhs = *(const gint64 *)b;
+
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static void run_transaction(HitakiEfwProtocol *protocol, guint serial)
+{
+    guint32 args[ARG_COUNT];
+    guint32 params[ARG_COUNT];
+    guint32 *const buf = params;
+    gsize param_count = G_N_ELEMENTS(params);
+    GError *error = NULL;
+    int i;
+
+    for (i = 0; i < ARG_COUNT; ++i)
+        args[i] = serial + i;
+
+    if (!hitaki_efw_protocol_transaction(protocol, 3, 0, args, G_N_ELEMENTS(args), &buf,
+                                         &param_count, TIMEOUT_MS, &error))
+        fail("transaction", error);
+}
+
+int main(void)
+{
+    HitakiSndEfw *unit;
+    struct dispatcher dispatcher;
+    GSource *src;
+    gint64 *latencies;
+    gint64 begin;
+    gint64 elapsed;
+    gint64 sum;
+    GError *error = NULL;
+    int i;
+
+    unit = hitaki_snd_efw_new();
+    if (!hitaki_alsa_firewire_open(HITAKI_ALSA_FIREWIRE(unit), LOOPBACK_PATH_PREFIX "fireworks",
+                                   0, &error))
+        fail("open", error);
+
+    dispatcher.ctx = g_main_context_new();
+    dispatcher.loop = g_main_loop_new(dispatcher.ctx, FALSE);
+    if (!hitaki_alsa_firewire_create_source(HITAKI_ALSA_FIREWIRE(unit), &src, &error))
+        fail("create_source", error);
+    g_source_attach(src, dispatcher.ctx);
+    dispatcher.thread = g_thread_new("dispatcher", run_dispatcher, &dispatcher);
+
+    for (i = 0; i < WARMUP_COUNT; ++i)
+        run_transaction(HITAKI_EFW_PROTOCOL(unit), i);
+
+    latencies = g_new(gint64, TRANSACTION_COUNT);
+    sum = 0;
+    begin = get_monotonic_ns();
+    for (i = 0; i < TRANSACTION_COUNT; ++i) {
+        gint64 start = get_monotonic_ns();
+
+        run_transaction(HITAKI_EFW_PROTOCOL(unit), i);
+        latencies[i] = get_monotonic_ns() - start;
+        sum += latencies[i];
+    }
+    elapsed = get_monotonic_ns() - begin;
+
+    g_main_context_invoke(dispatcher.ctx, quit_loop, dispatcher.loop);
+    g_thread_join(dispatcher.thread);
+    g_source_destroy(src);
+    g_source_unref(src);
+    g_main_loop_unref(dispatcher.loop);
+    g_main_context_unref(dispatcher.ctx);
+    g_object_unref(unit);
+
+    qsort(latencies, TRANSACTION_COUNT, sizeof(*latencies), compare_latency);
+
+    printf("{\n  \"benchmark\": \"efw-transaction\",\n  \"results\": [\n");
+    printf("    {\"scenario\": \"loopback-echo\", \"transactions\": %u, "
+           "\"elapsed_ns\": %" G_GINT64_FORMAT ", \"transactions_per_sec\": %.1f, "
+           "\"mean_ns\": %.1f, \"p50_ns\": %" G_GINT64_FORMAT ", \"p99_ns\": %" G_GINT64_FORMAT
+           ", \"max_ns\": %" G_GINT64_FORMAT "}\n",
+           TRANSACTION_COUNT, elapsed, (double)TRANSACTION_COUNT * 1e9 / (double)elapsed,
+           (double)sum / TRANSACTION_COUNT, latencies[TRANSACTION_COUNT / 2],
+           latencies[TRANSACTION_COUNT * 99 / 100], latencies[TRANSACTION_COUNT - 1]);
+    printf("  ]\n}\n");
+
+    g_free(latencies);
+
+    return EXIT_SUCCESS;
+}
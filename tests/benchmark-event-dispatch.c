@@ -0,0 +1,268 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#include "alsa_firewire_private.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Measure the throughput of events from the read(2) in the source dispatcher to the signal
+// emission by each unit. The synthetic events are injected into the loopback device in batch,
+// then dispatched by iterating the main context.
+
+#define EVENT_COUNT     100000
+#define BATCH_COUNT     64
+#define ITEM_COUNT      4
+
+struct scenario {
+    const char *name;
+    GType (*get_type)(void);
+    const char *path;
+    const char *signal;
+    GCallback handler;
+    gsize (*build)(guint8 *buf, guint serial);
+    // The number of handler calls per event.
+    guint calls_per_event;
+};
+
+static void handle_notified(GObject *unit, guint message, gpointer user_data)
+{
+    guint64 *calls = user_data;
+    ++*calls;
+}
+
+static void handle_notified_at(GObject *unit, guint message, guint tstamp, gpointer user_data)
+{
+    guint64 *calls = user_data;
+    ++*calls;
+}
+
+static void handle_tascam_changed(GObject *unit, guint index, guint before, guint after,
+                                  gpointer user_data)
+{
+    guint64 *calls = user_data;
+    ++*calls;
+}
+
+static void handle_motu_changed(GObject *unit, const guint32 *events, guint length,
+                                gpointer user_data)
+{
+    guint64 *calls = user_data;
+    ++*calls;
+}
+
+static gsize build_dice_notification(guint8 *buf, guint serial)
+{
+    struct snd_firewire_event_dice_notification *ev = (void *)buf;
+
+    ev->type = SNDRV_FIREWIRE_EVENT_DICE_NOTIFICATION;
+    ev->notification = serial;
+
+    return sizeof(*ev);
+}
+
+static gsize build_digi00x_message(guint8 *buf, guint serial)
+{
+    struct snd_firewire_event_digi00x_message *ev = (void *)buf;
+
+    ev->type = SNDRV_FIREWIRE_EVENT_DIGI00X_MESSAGE;
+    ev->message = serial;
+
+    return sizeof(*ev);
+}
+
+static gsize build_ff400_message(guint8 *buf, guint serial)
+{
+    struct snd_firewire_event_ff400_message *ev = (void *)buf;
+    int i;
+
+    ev->type = SNDRV_FIREWIRE_EVENT_FF400_MESSAGE;
+    ev->message_count = ITEM_COUNT;
+    for (i = 0; i < ITEM_COUNT; ++i) {
+        ev->messages[i].message = serial + i;
+        ev->messages[i].tstamp = (serial + i) % 8000;
+    }
+
+    return sizeof(*ev) + sizeof(ev->messages[0]) * ITEM_COUNT;
+}
+
+static gsize build_tascam_control(guint8 *buf, guint serial)
+{
+    struct snd_firewire_event_tascam_control *ev = (void *)buf;
+    int i;
+
+    ev->type = SNDRV_FIREWIRE_EVENT_TASCAM_CONTROL;
+    for (i = 0; i < ITEM_COUNT; ++i) {
+        ev->changes[i].index = (serial * ITEM_COUNT + i) % SNDRV_FIREWIRE_TASCAM_STATE_COUNT;
+        ev->changes[i].before = GUINT32_TO_BE(serial);
+        ev->changes[i].after = GUINT32_TO_BE(serial + 1);
+    }
+
+    return sizeof(*ev) + sizeof(ev->changes[0]) * ITEM_COUNT;
+}
+
+static gsize build_motu_register_dsp_change(guint8 *buf, guint serial)
+{
+    struct snd_firewire_event_motu_register_dsp_change *ev = (void *)buf;
+    int i;
+
+    ev->type = SNDRV_FIREWIRE_EVENT_MOTU_REGISTER_DSP_CHANGE;
+    ev->count = ITEM_COUNT;
+    // The change of mixer source gain; type 0x02, mixer, source and value.
+    for (i = 0; i < ITEM_COUNT; ++i)
+        ev->changes[i] = (0x02 << 24) | ((i % 4) << 16) | ((serial % 20) << 8) | (serial & 0x7f);
+
+    return sizeof(*ev) + sizeof(ev->changes[0]) * ITEM_COUNT;
+}
+
+static const struct scenario scenarios[] = {
+    {
+        "dice-notification",
+        hitaki_snd_dice_get_type,
+        LOOPBACK_PATH_PREFIX "dice",
+        "notified",
+        G_CALLBACK(handle_notified),
+        build_dice_notification,
+        1,
+    },
+    {
+        "digi00x-message",
+        hitaki_snd_digi00x_get_type,
+        LOOPBACK_PATH_PREFIX "digi00x",
+        "notified",
+        G_CALLBACK(handle_notified),
+        build_digi00x_message,
+        1,
+    },
+    {
+        "ff400-message",
+        hitaki_snd_fireface_get_type,
+        LOOPBACK_PATH_PREFIX "fireface",
+        "notified-at",
+        G_CALLBACK(handle_notified_at),
+        build_ff400_message,
+        ITEM_COUNT,
+    },
+    {
+        "tascam-control",
+        hitaki_snd_tascam_get_type,
+        LOOPBACK_PATH_PREFIX "tascam",
+        "changed",
+        G_CALLBACK(handle_tascam_changed),
+        build_tascam_control,
+        ITEM_COUNT,
+    },
+    {
+        "motu-register-dsp-change",
+        hitaki_snd_motu_get_type,
+        LOOPBACK_PATH_PREFIX "motu",
+        "changed",
+        G_CALLBACK(handle_motu_changed),
+        build_motu_register_dsp_change,
+        1,
+    },
+};
+
+static const guint budgets[] = { 1, BATCH_COUNT };
+
+static gint64 get_monotonic_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (gint64)ts.tv_sec * G_GINT64_CONSTANT(1000000000) + ts.tv_nsec;
+}
+
+static void fail(const gchar *label, GError *error)
+{
+    fprintf(stderr, "%s: %s\n", label, error != NULL ? error->message : "unknown");
+    exit(EXIT_FAILURE);
+}
+
+static gint64 run_scenario(const struct scenario *scenario, guint budget)
+{
+    HitakiAlsaFirewire *unit;
+    struct alsa_firewire_state *state;
+    GMainContext *ctx;
+    GSource *src;
+    guint64 calls = 0;
+    guint8 buf[256];
+    guint injected = 0;
+    gint64 begin;
+    gint64 elapsed;
+    GError *error = NULL;
+
+    unit = g_object_new(scenario->get_type(), NULL);
+    if (!hitaki_alsa_firewire_open(unit, scenario->path, O_NONBLOCK, &error))
+        fail(scenario->path, error);
+    g_object_set(unit, DISPATCH_BUDGET_PROP_NAME, budget, NULL);
+    g_signal_connect(unit, scenario->signal, scenario->handler, &calls);
+
+    ctx = g_main_context_new();
+    if (!hitaki_alsa_firewire_create_source(unit, &src, &error))
+        fail("create_source", error);
+    g_source_attach(src, ctx);
+
+    state = alsa_firewire_state_from_unit(unit);
+
+    begin = get_monotonic_ns();
+    while (injected < EVENT_COUNT) {
+        guint i;
+
+        for (i = 0; i < BATCH_COUNT && injected < EVENT_COUNT; ++i) {
+            gsize length = scenario->build(buf, injected);
+
+            // The packet is dropped when the socket is congested. Drain queued events then.
+            if (!alsa_firewire_loopback_inject_event(state, (const union snd_firewire_event *)buf,
+                                                     length, &error)) {
+                if (i == 0)
+                    fail("inject_event", error);
+                g_clear_error(&error);
+                break;
+            }
+            ++injected;
+        }
+
+        // The injected events are already queued, thus the iteration without events to dispatch
+        // means that some of them are lost.
+        while (calls < (guint64)injected * scenario->calls_per_event) {
+            if (!g_main_context_iteration(ctx, FALSE))
+                fail("dispatch", NULL);
+        }
+    }
+    elapsed = get_monotonic_ns() - begin;
+
+    g_source_destroy(src);
+    g_source_unref(src);
+    g_main_context_unref(ctx);
+    g_object_unref(unit);
+
+    return elapsed;
+}
+
+int main(void)
+{
+    int i, j;
+
+    printf("{\n  \"benchmark\": \"event-dispatch\",\n  \"results\": [\n");
+
+    for (i = 0; i < G_N_ELEMENTS(scenarios); ++i) {
+        for (j = 0; j < G_N_ELEMENTS(budgets); ++j) {
+            const struct scenario *scenario = &scenarios[i];
+            gint64 elapsed = run_scenario(scenario, budgets[j]);
+            gboolean is_last = (i == G_N_ELEMENTS(scenarios) - 1) &&
+                               (j == G_N_ELEMENTS(budgets) - 1);
+
+            printf("    {\"scenario\": \"%s\", \"dispatch_budget\": %u, \"events\": %u, "
+                   "\"elapsed_ns\": %" G_GINT64_FORMAT ", \"events_per_sec\": %.1f, "
+                   "\"ns_per_event\": %.1f}%s\n",
+                   scenario->name, budgets[j], EVENT_COUNT, elapsed,
+                   (double)EVENT_COUNT * 1e9 / (double)elapsed,
+                   (double)elapsed / (double)EVENT_COUNT, is_last ? "" : ",");
+        }
+    }
+
+    printf("  ]\n}\n");
+
+    return EXIT_SUCCESS;
+}
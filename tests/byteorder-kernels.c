@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#include "byteorder_private.h"
+
+// Check each kernel available in the host against the conversion per quadlet, for the counts
+// which exercise the tail of vectorized loop, in place and out of place.
+
+#define MAXIMUM_COUNT   17
+// Detect store beyond the count.
+#define GUARD           0xdeadbeef
+
+static void fill_source(guint32 *src, gsize count)
+{
+    gsize i;
+
+    for (i = 0; i < count; ++i)
+        src[i] = 0x01020304 + i * 0x11111111;
+    src[count] = GUARD;
+}
+
+static void check_result(const guint32 *dst, const guint32 *src, gsize count)
+{
+    gsize i;
+
+    for (i = 0; i < count; ++i)
+        g_assert_cmphex(dst[i], ==, GUINT32_SWAP_LE_BE(src[i]));
+    g_assert_cmphex(dst[count], ==, GUARD);
+}
+
+static void test_kernel(gconstpointer data)
+{
+    const struct swap_kernel *kernel = data;
+    guint32 src[MAXIMUM_COUNT + 1];
+    guint32 dst[MAXIMUM_COUNT + 1];
+    gsize count;
+
+    for (count = 0; count <= MAXIMUM_COUNT; ++count) {
+        fill_source(src, count);
+        dst[count] = GUARD;
+        kernel->func(dst, src, count);
+        check_result(dst, src, count);
+
+        // In place.
+        fill_source(dst, count);
+        kernel->func(dst, dst, count);
+        check_result(dst, src, count);
+    }
+}
+
+// The conversion for big endian is the same as the kernel in little endian host, and nothing in
+// big endian host.
+static void test_conversion(void)
+{
+    guint32 src[MAXIMUM_COUNT + 1];
+    guint32 dst[MAXIMUM_COUNT + 1];
+    gsize count;
+    gsize i;
+
+    for (count = 0; count <= MAXIMUM_COUNT; ++count) {
+        fill_source(src, count);
+
+        dst[count] = GUARD;
+        quadlets_from_be(dst, src, count);
+        for (i = 0; i < count; ++i)
+            g_assert_cmphex(dst[i], ==, GUINT32_FROM_BE(src[i]));
+        g_assert_cmphex(dst[count], ==, GUARD);
+
+        fill_source(dst, count);
+        quadlets_to_be(dst, dst, count);
+        for (i = 0; i < count; ++i)
+            g_assert_cmphex(dst[i], ==, GUINT32_TO_BE(src[i]));
+        g_assert_cmphex(dst[count], ==, GUARD);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    struct swap_kernel kernels[SWAP_KERNEL_COUNT_MAX];
+    guint kernel_count;
+    guint i;
+
+    g_test_init(&argc, &argv, NULL);
+
+    kernel_count = list_swap_kernels(kernels);
+    for (i = 0; i < kernel_count; ++i) {
+        gchar *path = g_strconcat("/byteorder/kernel/", kernels[i].name, NULL);
+
+        g_test_add_data_func(path, kernels + i, test_kernel);
+        g_free(path);
+    }
+    g_test_add_func("/byteorder/conversion", test_conversion);
+
+    return g_test_run();
+}
@@ -0,0 +1,248 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#include <hitaki.h>
+#include <sound/firewire.h>
+
+// Check parsing of response frame against the length field, by the object which implements the
+// interface and keeps the request frame.
+
+#define HEADER_QUADLETS     6
+#define MAXIMUM_QUADLETS    (0x200 / sizeof(guint32))
+#define PARAM_COUNT         2
+#define TIMEOUT_MS          1000
+#define MAXIMUM_BATCH       (SND_EFW_TRANSACTION_USER_SEQNUM_MAX / 2 + 1)
+
+#define TEST_TYPE_EFW   (test_efw_get_type())
+G_DECLARE_FINAL_TYPE(TestEfw, test_efw, TEST, EFW, GObject);
+
+struct _TestEfw {
+    GObject parent_instance;
+    guint32 seqnum;
+    guint32 request[MAXIMUM_QUADLETS];
+};
+
+static gboolean test_efw_transmit_request(HitakiEfwProtocol *protocol, const guint8 *buffer,
+                                          gsize length, GError **error)
+{
+    TestEfw *self = TEST_EFW(protocol);
+
+    g_assert_cmpuint(length, <=, sizeof(self->request));
+    memcpy(self->request, buffer, length);
+
+    return TRUE;
+}
+
+static void test_efw_get_seqnum(HitakiEfwProtocol *protocol, guint32 *seqnum)
+{
+    TestEfw *self = TEST_EFW(protocol);
+
+    *seqnum = self->seqnum;
+    self->seqnum += 2;
+}
+
+static void test_efw_protocol_init(HitakiEfwProtocolInterface *iface)
+{
+    iface->transmit_request = test_efw_transmit_request;
+    iface->get_seqnum = test_efw_get_seqnum;
+}
+
+G_DEFINE_TYPE_WITH_CODE(TestEfw, test_efw, G_TYPE_OBJECT,
+                        G_IMPLEMENT_INTERFACE(HITAKI_TYPE_EFW_PROTOCOL, test_efw_protocol_init))
+
+static void test_efw_class_init(TestEfwClass *klass)
+{
+    return;
+}
+
+static void test_efw_init(TestEfw *self)
+{
+    return;
+}
+
+struct frame_case {
+    // The value of length field in quadlets.
+    guint quadlet_count;
+    // The size of buffer given to parse.
+    gsize length;
+    // The status expected for the transaction.
+    HitakiEfwProtocolError status;
+};
+
+static const struct frame_case valid_frame = {
+    HEADER_QUADLETS + PARAM_COUNT,
+    (HEADER_QUADLETS + PARAM_COUNT) * sizeof(guint32),
+    HITAKI_EFW_PROTOCOL_ERROR_OK,
+};
+
+static const struct frame_case frame_below_header = {
+    HEADER_QUADLETS - 4,
+    HEADER_QUADLETS * sizeof(guint32),
+    HITAKI_EFW_PROTOCOL_ERROR_BAD_QUAD_COUNT,
+};
+
+static const struct frame_case frame_beyond_buffer = {
+    HEADER_QUADLETS + PARAM_COUNT + 4,
+    (HEADER_QUADLETS + PARAM_COUNT) * sizeof(guint32),
+    HITAKI_EFW_PROTOCOL_ERROR_BAD_QUAD_COUNT,
+};
+
+static const struct frame_case frame_beyond_maximum = {
+    MAXIMUM_QUADLETS + 1,
+    (MAXIMUM_QUADLETS + 1) * sizeof(guint32),
+    HITAKI_EFW_PROTOCOL_ERROR_BAD_QUAD_COUNT,
+};
+
+static void handle_finished(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    GAsyncResult **ptr = user_data;
+
+    *ptr = g_object_ref(result);
+}
+
+static void test_response(gconstpointer data)
+{
+    const struct frame_case *frame_case = data;
+    const guint32 args[PARAM_COUNT] = { 0x01234567, 0x89abcdef };
+    guint32 response[MAXIMUM_QUADLETS + 1] = { 0 };
+    guint32 params[PARAM_COUNT] = { 0 };
+    guint32 *const buf = params;
+    gsize param_count = G_N_ELEMENTS(params);
+    GAsyncResult *result = NULL;
+    GError *error = NULL;
+    TestEfw *protocol;
+    gboolean is_ok;
+    int i;
+
+    protocol = g_object_new(TEST_TYPE_EFW, NULL);
+
+    hitaki_efw_protocol_transaction_async(HITAKI_EFW_PROTOCOL(protocol), 3, 0, args,
+                                          G_N_ELEMENTS(args), TIMEOUT_MS, NULL, handle_finished,
+                                          &result);
+
+    // The response has the same content as the request, except for fields below.
+    memcpy(response, protocol->request, (HEADER_QUADLETS + PARAM_COUNT) * sizeof(guint32));
+    response[0] = GUINT32_TO_BE(frame_case->quadlet_count);
+    response[2] = GUINT32_TO_BE(GUINT32_FROM_BE(protocol->request[2]) + 1);
+    response[5] = GUINT32_TO_BE(HITAKI_EFW_PROTOCOL_ERROR_OK);
+
+    hitaki_efw_protocol_receive_response(HITAKI_EFW_PROTOCOL(protocol), (const guint8 *)response,
+                                         frame_case->length);
+
+    // The timeout bounds the iteration.
+    while (result == NULL)
+        g_main_context_iteration(NULL, TRUE);
+
+    is_ok = hitaki_efw_protocol_transaction_finish(HITAKI_EFW_PROTOCOL(protocol), result, &buf,
+                                                   &param_count, &error);
+    if (frame_case->status == HITAKI_EFW_PROTOCOL_ERROR_OK) {
+        g_assert_no_error(error);
+        g_assert_true(is_ok);
+        g_assert_cmpuint(param_count, ==, PARAM_COUNT);
+        for (i = 0; i < PARAM_COUNT; ++i)
+            g_assert_cmpuint(params[i], ==, args[i]);
+    } else {
+        g_assert_error(error, HITAKI_EFW_PROTOCOL_ERROR, frame_case->status);
+        g_assert_false(is_ok);
+        g_clear_error(&error);
+    }
+
+    g_object_unref(result);
+    g_object_unref(protocol);
+}
+
+// The transaction with the sequence number used by the pending transaction is refused, and the
+// pending transaction is still completed by the response.
+static void test_seqnum_collision(void)
+{
+    const guint32 args[PARAM_COUNT] = { 0x01234567, 0x89abcdef };
+    guint32 response[HEADER_QUADLETS + PARAM_COUNT];
+    guint32 params[PARAM_COUNT] = { 0 };
+    guint32 *const buf = params;
+    gsize param_count = G_N_ELEMENTS(params);
+    GAsyncResult *result = NULL;
+    GAsyncResult *refused = NULL;
+    GError *error = NULL;
+    TestEfw *protocol;
+
+    protocol = g_object_new(TEST_TYPE_EFW, NULL);
+
+    hitaki_efw_protocol_transaction_async(HITAKI_EFW_PROTOCOL(protocol), 3, 0, args,
+                                          G_N_ELEMENTS(args), TIMEOUT_MS, NULL, handle_finished,
+                                          &result);
+    memcpy(response, protocol->request, sizeof(response));
+
+    protocol->seqnum = 0;
+    hitaki_efw_protocol_transaction(HITAKI_EFW_PROTOCOL(protocol), 3, 0, args,
+                                    G_N_ELEMENTS(args), &buf, &param_count, TIMEOUT_MS, &error);
+    g_assert_error(error, HITAKI_EFW_PROTOCOL_ERROR, HITAKI_EFW_PROTOCOL_ERROR_BAD);
+    g_clear_error(&error);
+
+    protocol->seqnum = 0;
+    hitaki_efw_protocol_transaction_async(HITAKI_EFW_PROTOCOL(protocol), 3, 0, args,
+                                          G_N_ELEMENTS(args), TIMEOUT_MS, NULL, handle_finished,
+                                          &refused);
+    while (refused == NULL)
+        g_main_context_iteration(NULL, TRUE);
+    hitaki_efw_protocol_transaction_finish(HITAKI_EFW_PROTOCOL(protocol), refused, &buf,
+                                           &param_count, &error);
+    g_assert_error(error, HITAKI_EFW_PROTOCOL_ERROR, HITAKI_EFW_PROTOCOL_ERROR_BAD);
+    g_clear_error(&error);
+    g_object_unref(refused);
+
+    response[2] = GUINT32_TO_BE(GUINT32_FROM_BE(response[2]) + 1);
+    response[5] = GUINT32_TO_BE(HITAKI_EFW_PROTOCOL_ERROR_OK);
+    hitaki_efw_protocol_receive_response(HITAKI_EFW_PROTOCOL(protocol), (const guint8 *)response,
+                                         sizeof(response));
+
+    // The timeout bounds the iteration.
+    while (result == NULL)
+        g_main_context_iteration(NULL, TRUE);
+
+    hitaki_efw_protocol_transaction_finish(HITAKI_EFW_PROTOCOL(protocol), result, &buf,
+                                           &param_count, &error);
+    g_assert_no_error(error);
+    g_assert_cmpuint(param_count, ==, PARAM_COUNT);
+    g_object_unref(result);
+
+    g_object_unref(protocol);
+}
+
+// The batch with more requests than the sequence numbers available at the same time is rejected
+// before any transmission.
+static void test_batch_limit(void)
+{
+    gsize request_count = (MAXIMUM_BATCH + 1) * 3;
+    guint32 *requests = g_new0(guint32, request_count);
+    guint32 responses[2];
+    guint32 *const buf = responses;
+    gsize response_count = G_N_ELEMENTS(responses);
+    GError *error = NULL;
+    TestEfw *protocol;
+
+    protocol = g_object_new(TEST_TYPE_EFW, NULL);
+
+    hitaki_efw_protocol_transaction_batch(HITAKI_EFW_PROTOCOL(protocol), requests, request_count,
+                                          &buf, &response_count, TIMEOUT_MS, &error);
+    g_assert_error(error, HITAKI_EFW_PROTOCOL_ERROR, HITAKI_EFW_PROTOCOL_ERROR_BAD_QUAD_COUNT);
+    g_clear_error(&error);
+    g_assert_cmpuint(protocol->seqnum, ==, 0);
+
+    g_object_unref(protocol);
+    g_free(requests);
+}
+
+int main(int argc, char **argv)
+{
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_data_func("/efw-protocol/response/valid", &valid_frame, test_response);
+    g_test_add_data_func("/efw-protocol/response/below-header", &frame_below_header,
+                         test_response);
+    g_test_add_data_func("/efw-protocol/response/beyond-buffer", &frame_beyond_buffer,
+                         test_response);
+    g_test_add_data_func("/efw-protocol/response/beyond-maximum", &frame_beyond_maximum,
+                         test_response);
+    g_test_add_func("/efw-protocol/seqnum-collision", test_seqnum_collision);
+    g_test_add_func("/efw-protocol/batch-limit", test_batch_limit);
+
+    return g_test_run();
+}
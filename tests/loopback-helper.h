@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#ifndef __HITAKI_TESTS_LOOPBACK_HELPER_H__
+#define __HITAKI_TESTS_LOOPBACK_HELPER_H__
+
+#include "alsa_firewire_private.h"
+
+#include <fcntl.h>
+
+// The unit associated to the loopback device, and the source of unit attached to the own main
+// context, shared by the tests against the loopback device.
+struct loopback_fixture {
+    HitakiAlsaFirewire *unit;
+    struct alsa_firewire_state *state;
+    GMainContext *ctx;
+    GSource *src;
+};
+
+// The name is for the type of unit, like "dice".
+static inline void loopback_fixture_setup(struct loopback_fixture *fixture, GType type,
+                                          const char *name, gint open_flag)
+{
+    GError *error = NULL;
+    gchar *path;
+
+    path = g_strconcat(LOOPBACK_PATH_PREFIX, name, NULL);
+    fixture->unit = g_object_new(type, NULL);
+    hitaki_alsa_firewire_open(fixture->unit, path, open_flag, &error);
+    g_assert_no_error(error);
+    g_free(path);
+    fixture->state = alsa_firewire_state_from_unit(fixture->unit);
+
+    fixture->ctx = g_main_context_new();
+    hitaki_alsa_firewire_create_source(fixture->unit, &fixture->src, &error);
+    g_assert_no_error(error);
+    g_source_attach(fixture->src, fixture->ctx);
+}
+
+static inline void loopback_fixture_teardown(struct loopback_fixture *fixture)
+{
+    g_source_destroy(fixture->src);
+    g_source_unref(fixture->src);
+    g_main_context_unref(fixture->ctx);
+    g_object_unref(fixture->unit);
+}
+
+#endif
@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#include "loopback-helper.h"
+
+// Check the frames sampled by the thread against the loopback device, which emulates the float
+// meter of command DSP models.
+
+#define METER_COUNT     SNDRV_FIREWIRE_MOTU_COMMAND_DSP_METER_COUNT
+#define INTERVAL_MS     1
+#define WAIT_US         (G_USEC_PER_SEC)
+#define UPDATE_COUNT    200
+#define READ_COUNT      1000
+
+struct fixture {
+    struct loopback_fixture loopback;
+    HitakiSndMotu *unit;
+    HitakiMotuMeterSampler *sampler;
+};
+
+// Fill all of meters with the same value so that the torn frame is detectable.
+static void update_meter(struct fixture *fixture, gfloat value)
+{
+    struct snd_firewire_motu_command_dsp_meter meter;
+    GError *error = NULL;
+    int i;
+
+    for (i = 0; i < METER_COUNT; ++i)
+        meter.data[i] = value;
+
+    alsa_firewire_loopback_update(fixture->loopback.state, SNDRV_FIREWIRE_IOCTL_MOTU_COMMAND_DSP_METER,
+                                  &meter, sizeof(meter), &error);
+    g_assert_no_error(error);
+}
+
+static void read_meter(struct fixture *fixture, gfloat *meter, gint64 *timestamp,
+                       guint *sequence)
+{
+    gfloat *const buf = meter;
+    GError *error = NULL;
+    int i;
+
+    hitaki_motu_meter_sampler_read_float_meter(fixture->sampler, &buf, timestamp, sequence,
+                                               &error);
+    g_assert_no_error(error);
+
+    for (i = 1; i < METER_COUNT; ++i)
+        g_assert_cmpfloat(meter[i], ==, meter[0]);
+}
+
+// Wait for the frame sampled after the given sequence number.
+static guint wait_for_next_frame(struct fixture *fixture, gfloat *meter, gint64 *timestamp,
+                                 guint sequence)
+{
+    gint64 expiration = g_get_monotonic_time() + WAIT_US;
+    guint next;
+
+    do {
+        g_usleep(INTERVAL_MS * 1000);
+        read_meter(fixture, meter, timestamp, &next);
+    } while (next == sequence && g_get_monotonic_time() < expiration);
+
+    return next;
+}
+
+static void setup(struct fixture *fixture)
+{
+    loopback_fixture_setup(&fixture->loopback, HITAKI_TYPE_SND_MOTU, "motu", O_NONBLOCK);
+    fixture->unit = HITAKI_SND_MOTU(fixture->loopback.unit);
+
+    fixture->sampler = hitaki_motu_meter_sampler_new();
+    g_object_set(fixture->sampler, "interval", INTERVAL_MS, NULL);
+}
+
+static void teardown(struct fixture *fixture)
+{
+    hitaki_motu_meter_sampler_stop(fixture->sampler);
+    g_object_unref(fixture->sampler);
+    loopback_fixture_teardown(&fixture->loopback);
+}
+
+static void test_sampling(void)
+{
+    gfloat meter[METER_COUNT];
+    guint8 bytes[SNDRV_FIREWIRE_MOTU_REGISTER_DSP_METER_COUNT];
+    guint8 *const byte_buf = bytes;
+    struct fixture fixture;
+    gint64 timestamp, next_timestamp;
+    guint sequence, next_sequence;
+    GError *error = NULL;
+
+    setup(&fixture);
+
+    update_meter(&fixture, 0.5f);
+
+    // The first frame is sampled before return.
+    hitaki_motu_meter_sampler_start(fixture.sampler, fixture.unit, &error);
+    g_assert_no_error(error);
+    read_meter(&fixture, meter, &timestamp, &sequence);
+    g_assert_cmpfloat(meter[0], ==, 0.5f);
+    g_assert_cmpint(timestamp, >, 0);
+
+    update_meter(&fixture, 0.25f);
+    next_sequence = wait_for_next_frame(&fixture, meter, &next_timestamp, sequence);
+    g_assert_cmpuint(next_sequence, >, sequence);
+    g_assert_cmpint(next_timestamp, >, timestamp);
+
+    // The frame sampled after the update has the new value.
+    next_sequence = wait_for_next_frame(&fixture, meter, &next_timestamp, next_sequence);
+    g_assert_cmpfloat(meter[0], ==, 0.25f);
+
+    // The loopback device emulates command DSP models, thus byte meter is not available.
+    hitaki_motu_meter_sampler_read_byte_meter(fixture.sampler, &byte_buf, &timestamp,
+                                              &sequence, &error);
+    g_assert_error(error, HITAKI_ALSA_FIREWIRE_ERROR, HITAKI_ALSA_FIREWIRE_ERROR_WRONG_CLASS);
+    g_clear_error(&error);
+
+    // The latest frame is still available after stopped.
+    hitaki_motu_meter_sampler_stop(fixture.sampler);
+    read_meter(&fixture, meter, &timestamp, &sequence);
+    g_usleep(INTERVAL_MS * 10 * 1000);
+    read_meter(&fixture, meter, &next_timestamp, &next_sequence);
+    g_assert_cmpuint(next_sequence, ==, sequence);
+    g_assert_cmpint(next_timestamp, ==, timestamp);
+
+    teardown(&fixture);
+}
+
+// The reader never retrieves the frame torn by the sampler during update. The reader spins so
+// that it overlaps with the update.
+static void test_consistency(void)
+{
+    gfloat meter[METER_COUNT];
+    struct fixture fixture;
+    gint64 timestamp;
+    guint sequence;
+    GError *error = NULL;
+    int i, j;
+
+    setup(&fixture);
+
+    hitaki_motu_meter_sampler_start(fixture.sampler, fixture.unit, &error);
+    g_assert_no_error(error);
+
+    for (i = 0; i < UPDATE_COUNT; ++i) {
+        update_meter(&fixture, (gfloat)i / UPDATE_COUNT);
+        for (j = 0; j < READ_COUNT; ++j)
+            read_meter(&fixture, meter, &timestamp, &sequence);
+    }
+
+    teardown(&fixture);
+}
+
+int main(int argc, char **argv)
+{
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/motu-meter-sampler/loopback/sampling", test_sampling);
+    g_test_add_func("/motu-meter-sampler/loopback/consistency", test_consistency);
+
+    return g_test_run();
+}
@@ -0,0 +1,228 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#include "loopback-helper.h"
+
+// Check Fireworks transactions against the loopback device, which answers each request frame by
+// the response frame with the same parameters. The response is dispatched in the other thread,
+// as applications usually do.
+
+#define TIMEOUT_MS      1000
+#define CATEGORY        3
+#define MAX_RESPONSES   8
+
+struct fixture {
+    struct loopback_fixture loopback;
+    HitakiSndEfw *unit;
+    GMainLoop *loop;
+    GThread *thread;
+
+    GMutex lock;
+    guint seqnums[MAX_RESPONSES];
+    guint commands[MAX_RESPONSES];
+    guint response_count;
+};
+
+static void handle_responded(HitakiEfwProtocol *unit, guint version, guint seqnum, guint category,
+                             guint command, HitakiEfwProtocolError status, const guint32 *params,
+                             guint param_count, gpointer user_data)
+{
+    struct fixture *fixture = user_data;
+
+    g_assert_cmpuint(category, ==, CATEGORY);
+    g_assert_cmpuint(status, ==, HITAKI_EFW_PROTOCOL_ERROR_OK);
+
+    g_mutex_lock(&fixture->lock);
+    g_assert_cmpuint(fixture->response_count, <, MAX_RESPONSES);
+    fixture->seqnums[fixture->response_count] = seqnum;
+    fixture->commands[fixture->response_count] = command;
+    ++fixture->response_count;
+    g_mutex_unlock(&fixture->lock);
+}
+
+static gpointer run_dispatcher(gpointer data)
+{
+    struct fixture *fixture = data;
+
+    g_main_context_push_thread_default(fixture->loopback.ctx);
+    g_main_loop_run(fixture->loop);
+    g_main_context_pop_thread_default(fixture->loopback.ctx);
+
+    return NULL;
+}
+
+static gboolean quit_loop(gpointer data)
+{
+    g_main_loop_quit(data);
+    return G_SOURCE_REMOVE;
+}
+
+static void setup(struct fixture *fixture)
+{
+    loopback_fixture_setup(&fixture->loopback, HITAKI_TYPE_SND_EFW, "fireworks", O_NONBLOCK);
+    fixture->unit = HITAKI_SND_EFW(fixture->loopback.unit);
+
+    g_mutex_init(&fixture->lock);
+    fixture->response_count = 0;
+    g_signal_connect(fixture->unit, "responded", G_CALLBACK(handle_responded), fixture);
+
+    fixture->loop = g_main_loop_new(fixture->loopback.ctx, FALSE);
+    fixture->thread = g_thread_new("dispatcher", run_dispatcher, fixture);
+}
+
+static void teardown(struct fixture *fixture)
+{
+    HitakiAlsaFirewireStats *stats;
+    guint64 signal_count;
+
+    g_main_context_invoke(fixture->loopback.ctx, quit_loop, fixture->loop);
+    g_thread_join(fixture->thread);
+
+    // The signal is counted after the transaction finishes, thus check it after the dispatcher
+    // stops.
+    hitaki_alsa_firewire_get_stats(HITAKI_ALSA_FIREWIRE(fixture->unit), &stats);
+    hitaki_alsa_firewire_stats_get_signal_count(stats, &signal_count);
+    g_assert_cmpuint(signal_count, ==, fixture->response_count);
+    g_boxed_free(HITAKI_TYPE_ALSA_FIREWIRE_STATS, stats);
+
+    g_main_loop_unref(fixture->loop);
+    loopback_fixture_teardown(&fixture->loopback);
+    g_mutex_clear(&fixture->lock);
+}
+
+// The sequence number of response is incremented by 1 from the one of request, which begins with
+// zero at open and is incremented by 2 per request.
+static void check_responses(struct fixture *fixture, const guint *commands, guint count)
+{
+    guint i;
+
+    g_mutex_lock(&fixture->lock);
+    g_assert_cmpuint(fixture->response_count, ==, count);
+    for (i = 0; i < count; ++i) {
+        g_assert_cmpuint(fixture->seqnums[i], ==, i * 2 + 1);
+        g_assert_cmpuint(fixture->commands[i], ==, commands[i]);
+    }
+    g_mutex_unlock(&fixture->lock);
+}
+
+static void test_sync(void)
+{
+    const guint32 args[] = { 0x01234567, 0x89abcdef, 0xfedcba98 };
+    const guint commands[] = { 1, 2 };
+    guint32 params[G_N_ELEMENTS(args)];
+    guint32 *const buf = params;
+    struct fixture fixture;
+    GError *error = NULL;
+    gsize param_count;
+    int i;
+
+    setup(&fixture);
+
+    param_count = G_N_ELEMENTS(params);
+    hitaki_efw_protocol_transaction(HITAKI_EFW_PROTOCOL(fixture.unit), CATEGORY, commands[0],
+                                    args, G_N_ELEMENTS(args), &buf, &param_count, TIMEOUT_MS,
+                                    &error);
+    g_assert_no_error(error);
+    g_assert_cmpuint(param_count, ==, G_N_ELEMENTS(args));
+    for (i = 0; i < G_N_ELEMENTS(args); ++i)
+        g_assert_cmpuint(params[i], ==, args[i]);
+
+    // The transaction without arguments.
+    param_count = G_N_ELEMENTS(params);
+    hitaki_efw_protocol_transaction(HITAKI_EFW_PROTOCOL(fixture.unit), CATEGORY, commands[1],
+                                    NULL, 0, &buf, &param_count, TIMEOUT_MS, &error);
+    g_assert_no_error(error);
+
+    check_responses(&fixture, commands, G_N_ELEMENTS(commands));
+
+    teardown(&fixture);
+}
+
+static void handle_finished(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    GAsyncResult **ptr = user_data;
+
+    *ptr = g_object_ref(result);
+}
+
+static void test_async(void)
+{
+    const guint32 args[] = { 0x02468ace, 0x13579bdf };
+    const guint commands[] = { 4 };
+    guint32 params[G_N_ELEMENTS(args)];
+    guint32 *const buf = params;
+    gsize param_count = G_N_ELEMENTS(params);
+    struct fixture fixture;
+    GAsyncResult *result = NULL;
+    GError *error = NULL;
+    int i;
+
+    setup(&fixture);
+
+    hitaki_efw_protocol_transaction_async(HITAKI_EFW_PROTOCOL(fixture.unit), CATEGORY,
+                                          commands[0], args, G_N_ELEMENTS(args), TIMEOUT_MS, NULL,
+                                          handle_finished, &result);
+
+    // The callback is called in the thread-default main context of caller. The timeout bounds
+    // the iteration.
+    while (result == NULL)
+        g_main_context_iteration(NULL, TRUE);
+
+    hitaki_efw_protocol_transaction_finish(HITAKI_EFW_PROTOCOL(fixture.unit), result, &buf,
+                                           &param_count, &error);
+    g_assert_no_error(error);
+    g_assert_cmpuint(param_count, ==, G_N_ELEMENTS(args));
+    for (i = 0; i < G_N_ELEMENTS(args); ++i)
+        g_assert_cmpuint(params[i], ==, args[i]);
+    g_object_unref(result);
+
+    check_responses(&fixture, commands, G_N_ELEMENTS(commands));
+
+    teardown(&fixture);
+}
+
+static void test_batch(void)
+{
+    // Category, command, the number of arguments, and the arguments.
+    const guint32 requests[] = {
+        CATEGORY, 5, 0,
+        CATEGORY, 6, 1, 0x11111111,
+        CATEGORY, 7, 3, 0x22222222, 0x33333333, 0x44444444,
+    };
+    // Status, the number of parameters, and the parameters.
+    const guint32 expected[] = {
+        HITAKI_EFW_PROTOCOL_ERROR_OK, 0,
+        HITAKI_EFW_PROTOCOL_ERROR_OK, 1, 0x11111111,
+        HITAKI_EFW_PROTOCOL_ERROR_OK, 3, 0x22222222, 0x33333333, 0x44444444,
+    };
+    const guint commands[] = { 5, 6, 7 };
+    guint32 responses[32];
+    guint32 *const buf = responses;
+    gsize response_count = G_N_ELEMENTS(responses);
+    struct fixture fixture;
+    GError *error = NULL;
+    int i;
+
+    setup(&fixture);
+
+    hitaki_efw_protocol_transaction_batch(HITAKI_EFW_PROTOCOL(fixture.unit), requests,
+                                          G_N_ELEMENTS(requests), &buf, &response_count,
+                                          TIMEOUT_MS, &error);
+    g_assert_no_error(error);
+    g_assert_cmpuint(response_count, ==, G_N_ELEMENTS(expected));
+    for (i = 0; i < G_N_ELEMENTS(expected); ++i)
+        g_assert_cmpuint(responses[i], ==, expected[i]);
+
+    check_responses(&fixture, commands, G_N_ELEMENTS(commands));
+
+    teardown(&fixture);
+}
+
+int main(int argc, char **argv)
+{
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/snd-efw/loopback/sync", test_sync);
+    g_test_add_func("/snd-efw/loopback/async", test_async);
+    g_test_add_func("/snd-efw/loopback/batch", test_batch);
+
+    return g_test_run();
+}
@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#include "loopback-helper.h"
+
+// Check the cache of register DSP parameters patched by the events of change against the loopback
+// device, which emulates register DSP models.
+
+#define MIXER_COUNT     SNDRV_FIREWIRE_MOTU_REGISTER_DSP_MIXER_COUNT
+#define SRC_COUNT       SNDRV_FIREWIRE_MOTU_REGISTER_DSP_MIXER_SRC_COUNT
+#define INPUT_COUNT     SNDRV_FIREWIRE_MOTU_REGISTER_DSP_ALIGNED_INPUT_COUNT
+
+#define ENCODE(type, index0, index1, value) \
+    (((guint32)HITAKI_MOTU_REGISTER_DSP_PARAMETER_TYPE_##type << 24) | \
+     ((guint32)(index0) << 16) | ((guint32)(index1) << 8) | (guint32)(value))
+
+struct fixture {
+    struct loopback_fixture loopback;
+    HitakiSndMotu *unit;
+    guint emitted;
+};
+
+static void handle_parameter_changed(HitakiMotuRegisterDsp *unit,
+                                     HitakiMotuRegisterDspParameterType param_type, guint index0,
+                                     guint index1, guint value, gpointer user_data)
+{
+    struct fixture *fixture = user_data;
+
+    ++fixture->emitted;
+}
+
+static void setup(struct fixture *fixture)
+{
+    loopback_fixture_setup(&fixture->loopback, HITAKI_TYPE_SND_MOTU, "motu", O_NONBLOCK);
+    fixture->unit = HITAKI_SND_MOTU(fixture->loopback.unit);
+    g_signal_connect(fixture->unit, "parameter-changed", G_CALLBACK(handle_parameter_changed),
+                     fixture);
+    fixture->emitted = 0;
+}
+
+static void teardown(struct fixture *fixture)
+{
+    loopback_fixture_teardown(&fixture->loopback);
+}
+
+static void read_cached_parameter(struct fixture *fixture,
+                                  struct snd_firewire_motu_register_dsp_parameter *param)
+{
+    HitakiSndMotuRegisterDspParameter *buf = hitaki_snd_motu_register_dsp_parameter_new();
+    GError *error = NULL;
+
+    hitaki_snd_motu_read_cached_parameter(fixture->unit, &buf, &error);
+    g_assert_no_error(error);
+    memcpy(param, buf, sizeof(*param));
+    g_boxed_free(HITAKI_TYPE_MOTU_REGISTER_DSP_PARAMETER, buf);
+}
+
+// The cache refreshed by the image of device is patched by the events, while the events for
+// index out of range and unknown type are ignored.
+static void test_patch(void)
+{
+    const guint32 changes[] = {
+        ENCODE(MIXER_SOURCE_GAIN, 1, 3, 0x40),
+        ENCODE(MIXER_SOURCE_PAN, 0, 0, 0x41),
+        ENCODE(MIXER_SOURCE_FLAG, MIXER_COUNT - 1, SRC_COUNT - 1, 0x42),
+        ENCODE(MIXER_SOURCE_PAIRED_BALANCE, 2, 5, 0x43),
+        ENCODE(MIXER_SOURCE_PAIRED_WIDTH, 3, 19, 0x44),
+        ENCODE(MIXER_OUTPUT_PAIRED_VOLUME, 2, 0, 0x45),
+        ENCODE(MIXER_OUTPUT_PAIRED_FLAG, 1, 0, 0x46),
+        ENCODE(MAIN_OUTPUT_PAIRED_VOLUME, 0, 0, 0x47),
+        ENCODE(HP_OUTPUT_PAIRED_VOLUME, 0, 0, 0x48),
+        ENCODE(HP_OUTPUT_PAIRED_ASSIGNMENT, 0, 0, 0x49),
+        ENCODE(LINE_INPUT_BOOST, 0, 0, 0x4a),
+        ENCODE(LINE_INPUT_NOMINAL_LEVEL, 0, 0, 0x4b),
+        ENCODE(INPUT_GAIN_AND_INVERT, INPUT_COUNT - 1, 0, 0x4c),
+        ENCODE(INPUT_FLAG, 4, 0, 0x4d),
+        // The same parameter is changed again.
+        ENCODE(MIXER_SOURCE_GAIN, 1, 3, 0x4e),
+    };
+    const guint32 ignored[] = {
+        ENCODE(MIXER_SOURCE_GAIN, MIXER_COUNT, 0, 0x50),
+        ENCODE(MIXER_SOURCE_PAIRED_WIDTH, 0, SRC_COUNT, 0x51),
+        ENCODE(MIXER_OUTPUT_PAIRED_VOLUME, MIXER_COUNT, 0, 0x52),
+        ENCODE(INPUT_GAIN_AND_INVERT, INPUT_COUNT, 0, 0x53),
+        ENCODE(INPUT_FLAG, 0xff, 0, 0x54),
+        // Unknown type.
+        (0x01 << 24) | 0x55,
+    };
+    guint32 packet[2 + G_N_ELEMENTS(changes) + G_N_ELEMENTS(ignored)];
+    struct snd_firewire_motu_register_dsp_parameter image, expected, cached;
+    HitakiSndMotuRegisterDspParameter *buf = hitaki_snd_motu_register_dsp_parameter_new();
+    struct fixture fixture;
+    GError *error = NULL;
+    int i;
+
+    setup(&fixture);
+
+    // Refresh the cache by the image with distinct value in each byte.
+    for (i = 0; i < sizeof(image); ++i)
+        ((guint8 *)&image)[i] = i & 0x3f;
+    alsa_firewire_loopback_update(fixture.loopback.state,
+                                  SNDRV_FIREWIRE_IOCTL_MOTU_REGISTER_DSP_PARAMETER, &image,
+                                  sizeof(image), &error);
+    g_assert_no_error(error);
+    hitaki_motu_register_dsp_read_parameter(HITAKI_MOTU_REGISTER_DSP(fixture.unit), &buf, &error);
+    g_assert_no_error(error);
+    g_boxed_free(HITAKI_TYPE_MOTU_REGISTER_DSP_PARAMETER, buf);
+
+    read_cached_parameter(&fixture, &cached);
+    g_assert_cmpmem(&cached, sizeof(cached), &image, sizeof(image));
+
+    // The ignored events are interleaved with the others.
+    packet[0] = SNDRV_FIREWIRE_EVENT_MOTU_REGISTER_DSP_CHANGE;
+    packet[1] = G_N_ELEMENTS(changes) + G_N_ELEMENTS(ignored);
+    for (i = 0; i < G_N_ELEMENTS(ignored); ++i) {
+        packet[2 + i * 2] = ignored[i];
+        packet[2 + i * 2 + 1] = changes[i];
+    }
+    for (i = G_N_ELEMENTS(ignored); i < G_N_ELEMENTS(changes); ++i)
+        packet[2 + G_N_ELEMENTS(ignored) + i] = changes[i];
+
+    alsa_firewire_loopback_inject_event(fixture.loopback.state,
+                                        (const union snd_firewire_event *)packet, sizeof(packet),
+                                        &error);
+    g_assert_no_error(error);
+    g_assert_true(g_main_context_iteration(fixture.loopback.ctx, FALSE));
+    g_assert_cmpuint(fixture.emitted, ==, G_N_ELEMENTS(changes));
+
+    memcpy(&expected, &image, sizeof(expected));
+    expected.mixer.source[1].gain[3] = 0x4e;
+    expected.mixer.source[0].pan[0] = 0x41;
+    expected.mixer.source[MIXER_COUNT - 1].flag[SRC_COUNT - 1] = 0x42;
+    expected.mixer.source[2].paired_balance[5] = 0x43;
+    expected.mixer.source[3].paired_width[19] = 0x44;
+    expected.mixer.output.paired_volume[2] = 0x45;
+    expected.mixer.output.paired_flag[1] = 0x46;
+    expected.output.main_paired_volume = 0x47;
+    expected.output.hp_paired_volume = 0x48;
+    expected.output.hp_paired_assignment = 0x49;
+    expected.line_input.boost_flag = 0x4a;
+    expected.line_input.nominal_level_flag = 0x4b;
+    expected.input.gain_and_invert[INPUT_COUNT - 1] = 0x4c;
+    expected.input.flag[4] = 0x4d;
+
+    read_cached_parameter(&fixture, &cached);
+    g_assert_cmpmem(&cached, sizeof(cached), &expected, sizeof(expected));
+
+    teardown(&fixture);
+}
+
+int main(int argc, char **argv)
+{
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/snd-motu/loopback/patch", test_patch);
+
+    return g_test_run();
+}
@@ -0,0 +1,189 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+#include "loopback-helper.h"
+
+// Check the mirror of state image against the loopback device, which emits the event for the
+// changes of image as the kernel driver does.
+
+#define STATE_COUNT     SNDRV_FIREWIRE_TASCAM_STATE_COUNT
+// More than the range of 8 bit storage.
+#define PASSED_COUNT    300
+
+struct fixture {
+    struct loopback_fixture loopback;
+    HitakiSndTascam *unit;
+    struct snd_firewire_tascam_state image;
+    guint change_count;
+};
+
+static void handle_changed(HitakiTascamProtocol *unit, guint index, guint before, guint after,
+                           gpointer user_data)
+{
+    struct fixture *fixture = user_data;
+
+    // The change for index out of range is passed through.
+    if (index < STATE_COUNT)
+        g_assert_cmpuint(after, ==, GUINT32_FROM_BE(fixture->image.data[index]));
+    ++fixture->change_count;
+}
+
+static void setup(struct fixture *fixture)
+{
+    loopback_fixture_setup(&fixture->loopback, HITAKI_TYPE_SND_TASCAM, "tascam", O_NONBLOCK);
+    fixture->unit = HITAKI_SND_TASCAM(fixture->loopback.unit);
+    g_signal_connect(fixture->unit, "changed", G_CALLBACK(handle_changed), fixture);
+    memset(&fixture->image, 0, sizeof(fixture->image));
+}
+
+static void teardown(struct fixture *fixture)
+{
+    loopback_fixture_teardown(&fixture->loopback);
+}
+
+// Update the image in the loopback device, then dispatch the event for the changes.
+static void update_image(struct fixture *fixture, const guint *indices, const guint32 *values,
+                         guint count)
+{
+    GError *error = NULL;
+    guint i;
+
+    for (i = 0; i < count; ++i)
+        fixture->image.data[indices[i]] = GUINT32_TO_BE(values[i]);
+
+    fixture->change_count = 0;
+    alsa_firewire_loopback_update(fixture->loopback.state, SNDRV_FIREWIRE_IOCTL_TASCAM_STATE,
+                                  &fixture->image, sizeof(fixture->image), &error);
+    g_assert_no_error(error);
+
+    g_assert_true(g_main_context_iteration(fixture->loopback.ctx, FALSE));
+    g_assert_cmpuint(fixture->change_count, ==, count);
+}
+
+static void check_changes(struct fixture *fixture, guint *cursor, const guint *indices,
+                          const guint32 *values, guint count)
+{
+    guint32 buf[STATE_COUNT];
+    guint32 *const changes = buf;
+    gsize length = G_N_ELEMENTS(buf);
+    guint64 expected_mask = 0;
+    guint64 mask;
+    GError *error = NULL;
+    guint i;
+
+    for (i = 0; i < count; ++i)
+        expected_mask |= G_GUINT64_CONSTANT(1) << indices[i];
+
+    hitaki_snd_tascam_read_changes(fixture->unit, cursor, &mask, &changes, &length, &error);
+    g_assert_no_error(error);
+    g_assert_cmpuint(mask, ==, expected_mask);
+    g_assert_cmpuint(length, ==, count);
+    // The values are in the order of bits in the mask.
+    for (i = 0; i < count; ++i)
+        g_assert_cmpuint(buf[i], ==, values[i]);
+}
+
+static void test_mirror(void)
+{
+    const guint indices[] = { 3, 40, 63 };
+    const guint32 values[] = { 0x00000011, 0x00220000, 0x33000000 };
+    const guint next_indices[] = { 40 };
+    const guint32 next_values[] = { 0x44444444 };
+    const guint32 latest_values[] = { values[0], next_values[0], values[2] };
+    guint32 buf[STATE_COUNT];
+    guint32 *const image = buf;
+    gsize count = G_N_ELEMENTS(buf);
+    struct fixture fixture;
+    guint generation, next_generation;
+    guint cursor = 0;
+    GError *error = NULL;
+    guint i;
+
+    setup(&fixture);
+
+    // The image is zero at first, thus no change is retrieved.
+    check_changes(&fixture, &cursor, NULL, NULL, 0);
+    hitaki_snd_tascam_read_cached_state(fixture.unit, &image, &count, &generation, &error);
+    g_assert_no_error(error);
+    g_assert_cmpuint(count, ==, STATE_COUNT);
+
+    update_image(&fixture, indices, values, G_N_ELEMENTS(indices));
+
+    count = G_N_ELEMENTS(buf);
+    hitaki_snd_tascam_read_cached_state(fixture.unit, &image, &count, &next_generation, &error);
+    g_assert_no_error(error);
+    g_assert_cmpuint(next_generation, >, generation);
+    for (i = 0; i < STATE_COUNT; ++i)
+        g_assert_cmpuint(buf[i], ==, GUINT32_FROM_BE(fixture.image.data[i]));
+
+    check_changes(&fixture, &cursor, indices, values, G_N_ELEMENTS(indices));
+    g_assert_cmpuint(cursor, ==, next_generation);
+
+    // Nothing changed since the last read.
+    check_changes(&fixture, &cursor, NULL, NULL, 0);
+
+    update_image(&fixture, next_indices, next_values, G_N_ELEMENTS(next_indices));
+    check_changes(&fixture, &cursor, next_indices, next_values, G_N_ELEMENTS(next_indices));
+
+    // The consumer with the initial cursor retrieves all of quadlets different from zero.
+    cursor = 0;
+    check_changes(&fixture, &cursor, indices, latest_values, G_N_ELEMENTS(indices));
+
+    teardown(&fixture);
+}
+
+// The changes of the same index are coalesced even if many changes for index out of range
+// precede them.
+static void test_coalesce(void)
+{
+    const guint index = 5;
+    const guint32 values[] = { 0x00000001, 0x00000002, 0x00000003 };
+    guint8 packet[sizeof(struct snd_firewire_event_tascam_control) +
+                  sizeof(struct snd_firewire_tascam_change) * (PASSED_COUNT + 2)];
+    struct snd_firewire_event_tascam_control *event = (void *)packet;
+    guint32 buf[STATE_COUNT];
+    guint32 *const image = buf;
+    gsize count = G_N_ELEMENTS(buf);
+    struct fixture fixture;
+    guint generation;
+    GError *error = NULL;
+    guint i;
+
+    setup(&fixture);
+    g_object_set(fixture.unit, "coalesce", TRUE, NULL);
+
+    event->type = SNDRV_FIREWIRE_EVENT_TASCAM_CONTROL;
+    for (i = 0; i < PASSED_COUNT; ++i) {
+        event->changes[i].index = STATE_COUNT + i;
+        event->changes[i].before = 0;
+        event->changes[i].after = GUINT32_TO_BE(i);
+    }
+    for (i = 0; i < 2; ++i) {
+        event->changes[PASSED_COUNT + i].index = index;
+        event->changes[PASSED_COUNT + i].before = GUINT32_TO_BE(values[i]);
+        event->changes[PASSED_COUNT + i].after = GUINT32_TO_BE(values[i + 1]);
+    }
+    fixture.image.data[index] = GUINT32_TO_BE(values[2]);
+
+    fixture.change_count = 0;
+    alsa_firewire_loopback_inject_event(fixture.loopback.state,
+                                        (const union snd_firewire_event *)event, sizeof(packet),
+                                        &error);
+    g_assert_no_error(error);
+    g_assert_true(g_main_context_iteration(fixture.loopback.ctx, FALSE));
+    g_assert_cmpuint(fixture.change_count, ==, PASSED_COUNT + 1);
+
+    hitaki_snd_tascam_read_cached_state(fixture.unit, &image, &count, &generation, &error);
+    g_assert_no_error(error);
+    g_assert_cmpuint(buf[index], ==, values[2]);
+
+    teardown(&fixture);
+}
+
+int main(int argc, char **argv)
+{
+    g_test_init(&argc, &argv, NULL);
+
+    g_test_add_func("/snd-tascam/loopback/mirror", test_mirror);
+    g_test_add_func("/snd-tascam/loopback/coalesce", test_coalesce);
+
+    return g_test_run();
+}